@@ -0,0 +1,73 @@
+#ifndef INC_BENCH_COMMON_H_
+#define INC_BENCH_COMMON_H_
+
+#define _POSIX_C_SOURCE 199309L
+#include "static_queue.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * Helpers shared by the benchmarks
+ */
+
+typedef struct {
+    uint64_t          payload[8];
+    staticQueueItem_t node;
+} travItem_t;
+
+static uint32_t g_rand_state = 0x12345678;
+
+static inline uint32_t benchRand(void)
+{
+    g_rand_state ^= g_rand_state << 13;
+    g_rand_state ^= g_rand_state >> 17;
+    g_rand_state ^= g_rand_state << 5;
+    return g_rand_state;
+}
+
+static inline uint64_t nowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Fill the queue and link the nodes in random order, this is the state a long running queue
+ * ends up in after many middle erases. One item is pop'ed so the counting functions can not
+ * take the full queue shortcut.
+ */
+static inline void scrambleQueue(staticQueue_t* queue, travItem_t* items, uint32_t* perm, uint32_t num_items)
+{
+    staticQueueItem_t* item;
+    memset(items, 0, sizeof(items[0]) * num_items);
+    staticQueueInit(queue, num_items, sizeof(items[0]), &items->node);
+    for (uint32_t i = 0; i < num_items; i++) {
+        staticQueuePut(queue, &item);
+        travItem_t* trav_item = CONTAINER_OF(item, travItem_t, node);
+        trav_item->payload[0] = i;
+        perm[i] = i;
+    }
+
+    for (uint32_t i = num_items - 1; i > 0; i--) {
+        uint32_t j   = benchRand() % (i + 1);
+        uint32_t tmp = perm[i];
+        perm[i]      = perm[j];
+        perm[j]      = tmp;
+    }
+
+    for (uint32_t i = 0; i < num_items; i++) {
+        staticQueueItem_t* node = &items[perm[i]].node;
+        node->next              = &items[perm[(i + 1) % num_items]].node;
+        node->next->last        = node;
+    }
+
+    queue->tail     = &items[perm[0]].node;
+    queue->head     = queue->tail;
+    queue->in_order = false;
+    staticQueuePop(queue, &item);
+}
+
+#endif /* INC_BENCH_COMMON_H_ */
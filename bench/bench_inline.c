@@ -0,0 +1,77 @@
+#include "bench_common.h"
+#include "static_queue_typed.h"
+
+/**
+ * Call overhead of the hot paths. This file is built with and without STATIC_QUEUE_INLINE,
+ * compare the output of bench_inline_call and bench_inline_header. Both are plain -O2 builds
+ * without LTO. The typed STATIC_QUEUE_DEFINE queue is the same in both, it is the floor.
+ */
+
+#define QUEUE_LEN (64u)
+#define BATCH     (48u)
+#define ROUNDS    (1u << 20)
+
+typedef struct {
+    uint64_t          value;
+    staticQueueItem_t node;
+} benchItem_t;
+
+STATIC_QUEUE_DEFINE(typedQueue, uint64_t, QUEUE_LEN);
+
+static benchItem_t g_items[QUEUE_LEN];
+static typedQueue_t g_typed_queue;
+
+int main() {
+
+    staticQueue_t      queue;
+    staticQueueItem_t* item  = NULL;
+    uint64_t*          value = NULL;
+    uint64_t           sum   = 0;
+
+    STATIC_QUEUE_INIT(&queue, g_items, QUEUE_LEN);
+    typedQueueInit(&g_typed_queue);
+
+    // Put a batch, then peak and pop it back, so every call is a hit
+    uint64_t start = nowNs();
+    for (uint32_t round = 0; round < ROUNDS; round++) {
+        for (uint32_t i = 0; i < BATCH; i++) {
+            staticQueuePut(&queue, &item);
+            benchItem_t* bench_item = CONTAINER_OF(item, benchItem_t, node);
+            bench_item->value       = i + round;
+        }
+        while (!staticQueueEmpty(&queue)) {
+            staticQueuePeak(&queue, &item);
+            staticQueuePop(&queue, &item);
+            benchItem_t* bench_item = CONTAINER_OF(item, benchItem_t, node);
+            sum += bench_item->value;
+        }
+    }
+    uint64_t generic_ns = nowNs() - start;
+
+    start = nowNs();
+    for (uint32_t round = 0; round < ROUNDS; round++) {
+        for (uint32_t i = 0; i < BATCH; i++) {
+            typedQueuePut(&g_typed_queue, &value);
+            *value = i + round;
+        }
+        while (!typedQueueEmpty(&g_typed_queue)) {
+            typedQueuePeak(&g_typed_queue, &value);
+            typedQueuePop(&g_typed_queue, &value);
+            sum += *value;
+        }
+    }
+    uint64_t typed_ns = nowNs() - start;
+
+    // Put, Peak, Pop and Empty calls per item
+    double ops = (double)ROUNDS * BATCH * 4;
+#ifdef STATIC_QUEUE_INLINE
+    printf("\n=== Hot paths inlined from static_queue_inline.h ===\n");
+#else
+    printf("\n=== Hot paths called in static_queue.c ===\n");
+#endif
+    printf("Generic queue: %.2f ns/op\n", generic_ns / ops);
+    printf("Typed queue:   %.2f ns/op\n", typed_ns / ops);
+    printf("\nChecksum %llu\n", (unsigned long long)sum);
+
+    return 0;
+}
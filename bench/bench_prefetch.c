@@ -0,0 +1,75 @@
+#include "bench_common.h"
+
+/**
+ * Traversal and pop cost on a scrambled queue. This file is built once per
+ * STATIC_QUEUE_PREFETCH_DISTANCE, compare the output of the bench_prefetch_d* binaries.
+ */
+
+#define NUM_ITEMS (1u << 20)
+#define RUNS      (3u)
+
+static travItem_t g_items[NUM_ITEMS];
+static uint32_t   g_perm[NUM_ITEMS];
+
+static int32_t sumCallback(staticQueue_t* queue, staticQueueItem_t* item, void* ctx)
+{
+    (void)queue;
+    travItem_t* trav_item = CONTAINER_OF(item, travItem_t, node);
+    *(uint64_t*)ctx += trav_item->payload[0];
+    return STATIC_QUEUE_CB_NEXT;
+}
+
+// Callback doing some work per item, this is where prefetching can hide the miss latency
+static int32_t workCallback(staticQueue_t* queue, staticQueueItem_t* item, void* ctx)
+{
+    (void)queue;
+    travItem_t* trav_item = CONTAINER_OF(item, travItem_t, node);
+    uint64_t    value     = trav_item->payload[0];
+    for (uint32_t i = 0; i < 64; i++) {
+        value = value * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    *(uint64_t*)ctx += value;
+    return STATIC_QUEUE_CB_NEXT;
+}
+
+int main() {
+
+    staticQueue_t queue;
+    uint64_t      sum        = 0;
+    uint64_t      foreach_ns = 0;
+    uint64_t      pop_ns     = 0;
+    uint64_t      work_ns    = 0;
+
+    for (uint32_t run = 0; run < RUNS; run++) {
+        scrambleQueue(&queue, g_items, g_perm, NUM_ITEMS);
+
+        uint64_t start = nowNs();
+        staticQueueForEachCtx(&queue, sumCallback, &sum);
+        uint64_t stop = nowNs();
+        foreach_ns += stop - start;
+
+        start = nowNs();
+        staticQueueForEachCtx(&queue, workCallback, &sum);
+        stop = nowNs();
+        work_ns += stop - start;
+
+        staticQueueItem_t* item;
+        start = nowNs();
+        while (staticQueuePop(&queue, &item) == STATIC_QUEUE_SUCCESS) {
+            travItem_t* trav_item = CONTAINER_OF(item, travItem_t, node);
+            sum += trav_item->payload[0];
+        }
+        stop = nowNs();
+        pop_ns += stop - start;
+    }
+
+    double items = (double)NUM_ITEMS * RUNS;
+    printf("\n=== Scrambled queue of %u items, prefetch distance %u ===\n",
+           NUM_ITEMS, STATIC_QUEUE_PREFETCH_DISTANCE);
+    printf("ForEach:     %.2f ns/item\n", foreach_ns / items);
+    printf("ForEach+work %.2f ns/item\n", work_ns / items);
+    printf("Pop drain:   %.2f ns/item\n", pop_ns / items);
+    printf("\nChecksum %llu\n", (unsigned long long)sum);
+
+    return 0;
+}
@@ -0,0 +1,201 @@
+#include "bench_common.h"
+
+/**
+ * Replay of a recorded operation trace. Record production traffic with staticQueueTraceStart and
+ * store it in the file format below, then run the same trace against each build of the queue.
+ * This file is built as bench_replay, bench_replay_inline and bench_replay_prefetch, compare
+ * their output. All of them are built with STATIC_QUEUE_TRACE so they can record, the replay
+ * queue itself is never traced.
+ *
+ *     bench_replay                     record a synthetic mix and replay it
+ *     bench_replay --save trace_file   the same, and store the synthetic trace
+ *     bench_replay trace_file          replay a stored trace
+ *
+ * A trace file is four uint32_t, magic, version, queue length and number of records, followed
+ * by the records, all in host byte order.
+ */
+
+#define TRACE_MAGIC   (0x52545153u) // "SQTR"
+#define TRACE_VERSION (1u)
+
+#define MAX_RECORDS     (1u << 22)
+#define SYNTH_QUEUE_LEN (4096u)
+#define SYNTH_OPS       (1u << 21)
+#define RUNS            (5u)
+
+static uint32_t g_records[MAX_RECORDS];
+
+// Items put with a mark are erased by the ForEach passes of the synthetic mix
+static int32_t eraseMarkedCallback(staticQueue_t* queue, staticQueueItem_t* item, void* ctx)
+{
+    (void)queue;
+    (void)ctx;
+    travItem_t* trav_item = CONTAINER_OF(item, travItem_t, node);
+    return trav_item->payload[1] != 0 ? STATIC_QUEUE_CB_ERASE : STATIC_QUEUE_CB_NEXT;
+}
+
+static void fillItem(staticQueueItem_t* item, uint32_t value)
+{
+    travItem_t* trav_item = CONTAINER_OF(item, travItem_t, node);
+    trav_item->payload[0] = value;
+    trav_item->payload[1] = benchRand() % 16 == 0;
+}
+
+/**
+ * Put, put first, pop, pop last, middle erases and ForEach erases around a half full queue.
+ * The middle erases scramble the ring like a long running queue.
+ */
+static int32_t recordSynthetic(staticQueueTrace_t* trace)
+{
+    staticQueue_t      queue;
+    staticQueueItem_t* item;
+    travItem_t*        items = calloc(SYNTH_QUEUE_LEN, sizeof(travItem_t));
+    if (items == NULL) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    staticQueueInit(&queue, SYNTH_QUEUE_LEN, sizeof(travItem_t), &items->node);
+    staticQueueTraceStart(&queue, trace, g_records, MAX_RECORDS);
+
+    for (uint32_t op = 0; op < SYNTH_OPS; op++) {
+        uint32_t put_share = staticQueueGetNumItems(&queue) < (int32_t)SYNTH_QUEUE_LEN / 2 ? 550 : 450;
+        uint32_t r         = benchRand() % 1000;
+
+        if (r < put_share) {
+            if (staticQueuefull(&queue)) {
+                staticQueuePop(&queue, &item);
+            }
+            if (r % 8 == 0) {
+                staticQueuePutFirst(&queue, &item);
+            } else {
+                staticQueuePut(&queue, &item);
+            }
+            fillItem(item, op);
+        } else if (r < 900) {
+            staticQueuePop(&queue, &item);
+        } else if (r < 940) {
+            staticQueuePopLast(&queue, &item);
+        } else if (r < 998) {
+            item = &items[benchRand() % SYNTH_QUEUE_LEN].node;
+            if (item->active) {
+                staticQueueErase(&queue, item);
+            }
+        } else {
+            staticQueueForEachCtx(&queue, eraseMarkedCallback, NULL);
+        }
+    }
+
+    staticQueueTraceStop(&queue);
+    free(items);
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+static int32_t loadTrace(const char* path, uint32_t* queue_length, uint32_t* num_records)
+{
+    uint32_t header[4];
+    FILE*    file = fopen(path, "rb");
+    if (file == NULL) {
+        return STATIC_QUEUE_IO_ERROR;
+    }
+
+    int32_t result = STATIC_QUEUE_INVALID;
+    if (fread(header, sizeof(header), 1, file) == 1 && header[0] == TRACE_MAGIC &&
+        header[1] == TRACE_VERSION && header[2] > 0 && header[3] <= MAX_RECORDS &&
+        fread(g_records, sizeof(g_records[0]), header[3], file) == header[3]) {
+        *queue_length = header[2];
+        *num_records  = header[3];
+        result        = STATIC_QUEUE_SUCCESS;
+    }
+
+    fclose(file);
+    return result;
+}
+
+static int32_t saveTrace(const char* path, uint32_t queue_length, uint32_t num_records)
+{
+    uint32_t header[4] = {TRACE_MAGIC, TRACE_VERSION, queue_length, num_records};
+    FILE*    file      = fopen(path, "wb");
+    if (file == NULL) {
+        return STATIC_QUEUE_IO_ERROR;
+    }
+
+    bool written = fwrite(header, sizeof(header), 1, file) == 1 &&
+                   fwrite(g_records, sizeof(g_records[0]), num_records, file) == num_records;
+
+    return fclose(file) == 0 && written ? STATIC_QUEUE_SUCCESS : STATIC_QUEUE_IO_ERROR;
+}
+
+// The application work on every item the trace returns or visits
+static int32_t visitCallback(staticQueue_t* queue, staticQueueItem_t* item, void* ctx)
+{
+    (void)queue;
+    travItem_t* trav_item = CONTAINER_OF(item, travItem_t, node);
+    trav_item->payload[0] += 1;
+    *(uint64_t*)ctx += trav_item->payload[0];
+    return STATIC_QUEUE_CB_NEXT;
+}
+
+int main(int argc, char** argv) {
+
+    staticQueue_t queue;
+    uint32_t      queue_length = SYNTH_QUEUE_LEN;
+    uint32_t      num_records  = 0;
+    uint64_t      sum          = 0;
+    int32_t       result;
+
+    if (argc == 2) {
+        result = loadTrace(argv[1], &queue_length, &num_records);
+        if (result != STATIC_QUEUE_SUCCESS) {
+            printf("Could not load trace %s (result: %i)\n", argv[1], result);
+            return 1;
+        }
+    } else {
+        staticQueueTrace_t trace;
+        recordSynthetic(&trace);
+        num_records = trace.num_records;
+        printf("Synthetic trace: %u records, %u dropped\n", trace.num_records, trace.dropped);
+
+        if (argc == 3 && strcmp(argv[1], "--save") == 0 &&
+            saveTrace(argv[2], queue_length, num_records) != STATIC_QUEUE_SUCCESS) {
+            printf("Could not save trace %s\n", argv[2]);
+            return 1;
+        }
+    }
+
+    travItem_t* items = calloc(queue_length, sizeof(travItem_t));
+    if (items == NULL) {
+        return 1;
+    }
+
+    // Best of a few runs, each from a freshly initialized queue
+    uint64_t best_ns = UINT64_MAX;
+    for (uint32_t run = 0; run < RUNS; run++) {
+        memset(items, 0, sizeof(travItem_t) * queue_length);
+        staticQueueInit(&queue, queue_length, sizeof(travItem_t), &items->node);
+
+        uint64_t start = nowNs();
+        result         = staticQueueTraceReplay(&queue, g_records, num_records, visitCallback, &sum);
+        uint64_t ns    = nowNs() - start;
+
+        if (result != (int32_t)num_records) {
+            printf("Replay diverged after %i records\n", result);
+            return 1;
+        }
+        best_ns = ns < best_ns ? ns : best_ns;
+    }
+
+#if defined(STATIC_QUEUE_INLINE)
+    printf("\n=== Replay, hot paths inlined from static_queue_inline.h ===\n");
+#elif STATIC_QUEUE_PREFETCH_DISTANCE > 0
+    printf("\n=== Replay, prefetch distance %d ===\n", STATIC_QUEUE_PREFETCH_DISTANCE);
+#else
+    printf("\n=== Replay, default build ===\n");
+#endif
+    printf("Queue length %u, %u records\n", queue_length, num_records);
+    printf("Replay: %.2f ns/record\n", (double)best_ns / num_records);
+    printf("\nChecksum %llu\n", (unsigned long long)sum);
+
+    free(items);
+    return 0;
+}
@@ -0,0 +1,261 @@
+#include "bench_common.h"
+
+/**
+ * Benchmarks for the static queue. Results are reported as ns per operation, run the binary
+ * under "perf stat -e cache-misses" to get the hardware counters as well.
+ */
+
+#define CACHE_ITEMS   (1u << 16)
+#define PAYLOAD_SIZE  (256u)
+#define WORKING_SET   (16u)
+#define ROUNDS        (1u << 20)
+
+typedef struct {
+    uint8_t           payload[PAYLOAD_SIZE];
+    staticQueueItem_t node;
+} benchItem_t;
+
+static benchItem_t g_items[CACHE_ITEMS];
+
+#define TRAVERSE_ITEMS (1u << 19)
+
+static travItem_t g_trav_items[TRAVERSE_ITEMS];
+static uint32_t   g_perm[TRAVERSE_ITEMS];
+
+// Touch every cache line of the payload, like a user filling a recycled buffer would
+static uint32_t touchPayload(benchItem_t* item)
+{
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < PAYLOAD_SIZE; i += 64) {
+        item->payload[i]++;
+        sum += item->payload[i];
+    }
+    return sum;
+}
+
+static void fillCache(staticQueue_t* queue)
+{
+    staticQueueItem_t* item;
+    memset(g_items, 0, sizeof(g_items));
+    STATIC_QUEUE_INIT(queue, g_items, CACHE_ITEMS);
+    while (staticQueuePut(queue, &item) == STATIC_QUEUE_SUCCESS) {
+    }
+}
+
+/**
+ * Use the queue as a free list of buffers. Take a small working set, use it and give it back.
+ * FIFO hands out the least recently returned buffer, LIFO the most recently returned one.
+ */
+static double benchObjectCache(bool lifo, uint32_t* checksum)
+{
+    staticQueue_t      queue;
+    staticQueueItem_t* taken[WORKING_SET];
+
+    fillCache(&queue);
+
+    uint64_t start = nowNs();
+    for (uint32_t round = 0; round < ROUNDS / WORKING_SET; round++) {
+        for (uint32_t i = 0; i < WORKING_SET; i++) {
+            if (lifo) {
+                staticQueuePopLast(&queue, &taken[i]);
+            } else {
+                staticQueuePop(&queue, &taken[i]);
+            }
+            *checksum += touchPayload(CONTAINER_OF(taken[i], benchItem_t, node));
+        }
+
+        // Give the buffers back, the queue only manages slots so re-putting recycles them
+        for (uint32_t i = 0; i < WORKING_SET; i++) {
+            staticQueueItem_t* item;
+            staticQueuePut(&queue, &item);
+        }
+    }
+    uint64_t stop = nowNs();
+
+    return (double)(stop - start) / (double)ROUNDS;
+}
+
+static int32_t sumCallback(staticQueue_t* queue, staticQueueItem_t* item, void* ctx)
+{
+    (void)queue;
+    travItem_t* trav_item = CONTAINER_OF(item, travItem_t, node);
+    *(uint64_t*)ctx += trav_item->payload[0];
+    return STATIC_QUEUE_CB_NEXT;
+}
+
+static void swapTravItem(staticQueueItem_t* a, staticQueueItem_t* b, void* ctx)
+{
+    (void)ctx;
+    travItem_t* item_a = CONTAINER_OF(a, travItem_t, node);
+    travItem_t* item_b = CONTAINER_OF(b, travItem_t, node);
+    uint64_t    tmp[8];
+    memcpy(tmp, item_a->payload, sizeof(tmp));
+    memcpy(item_a->payload, item_b->payload, sizeof(tmp));
+    memcpy(item_b->payload, tmp, sizeof(tmp));
+}
+
+static void benchTraversal(staticQueue_t* queue, const char* label, uint64_t* checksum)
+{
+    int32_t  num   = staticQueueGetNumItems(queue);
+    uint64_t start = nowNs();
+    staticQueueForEachCtx(queue, sumCallback, checksum);
+    uint64_t stop  = nowNs();
+
+    printf("%s ForEach: %.2f ns/item\n", label, (double)(stop - start) / num);
+}
+
+#define VALUE_QUEUE_LEN (256u)
+#define VALUE_BATCH     (32u)
+
+static travItem_t g_value_items[VALUE_QUEUE_LEN];
+
+// Move 64 byte messages through a queue, per item Put/Pop plus a copy against the bulk value API
+static void benchValueApi(uint64_t* checksum)
+{
+    staticQueue_t      queue;
+    staticQueueItem_t* item;
+    uint64_t           msgs[VALUE_BATCH][8] = {{0}};
+
+    STATIC_QUEUE_INIT(&queue, g_value_items, VALUE_QUEUE_LEN);
+    STATIC_QUEUE_SET_PAYLOAD(&queue, travItem_t, payload);
+
+    uint64_t start = nowNs();
+    for (uint32_t round = 0; round < ROUNDS; round++) {
+        msgs[round % VALUE_BATCH][0] = round;
+        for (uint32_t i = 0; i < VALUE_BATCH; i++) {
+            staticQueuePut(&queue, &item);
+            travItem_t* trav_item = CONTAINER_OF(item, travItem_t, node);
+            memcpy(trav_item->payload, msgs[i], sizeof(msgs[i]));
+        }
+        for (uint32_t i = 0; i < VALUE_BATCH; i++) {
+            staticQueuePop(&queue, &item);
+            travItem_t* trav_item = CONTAINER_OF(item, travItem_t, node);
+            memcpy(msgs[i], trav_item->payload, sizeof(msgs[i]));
+        }
+        *checksum += msgs[VALUE_BATCH - 1][0];
+    }
+    uint64_t put_ns = nowNs() - start;
+
+    start = nowNs();
+    for (uint32_t round = 0; round < ROUNDS; round++) {
+        msgs[round % VALUE_BATCH][0] = round;
+        staticQueuePushMany(&queue, msgs, VALUE_BATCH);
+        staticQueueTakeMany(&queue, msgs, VALUE_BATCH);
+        *checksum += msgs[VALUE_BATCH - 1][0];
+    }
+    uint64_t push_ns = nowNs() - start;
+
+    double num = (double)ROUNDS * VALUE_BATCH;
+    printf("Put/Pop + memcpy:     %.2f ns/msg\n", put_ns / num);
+    printf("PushMany/TakeMany:    %.2f ns/msg\n", push_ns / num);
+}
+
+#define EXPIRE_QUEUE_LEN (4096u)
+#define EXPIRE_PER_TICK  (64u)
+#define EXPIRE_TTL       (32u)
+#define EXPIRE_TICKS     (1u << 14)
+
+static travItem_t g_expire_items[EXPIRE_QUEUE_LEN];
+static uint64_t   g_tick;
+
+static uint64_t tickClock(void* ctx)
+{
+    (void)ctx;
+    return g_tick;
+}
+
+static int32_t eraseStaleCallback(staticQueue_t* queue, staticQueueItem_t* item, void* ctx)
+{
+    (void)queue;
+    travItem_t* trav_item = CONTAINER_OF(item, travItem_t, node);
+    return g_tick - trav_item->payload[0] >= *(uint64_t*)ctx ? STATIC_QUEUE_CB_ERASE : STATIC_QUEUE_CB_NEXT;
+}
+
+// Each tick puts a batch and drops what is older than the ttl, about half the queue stays alive
+static void benchExpire(bool sweep)
+{
+    staticQueue_t      queue;
+    staticQueueItem_t* item;
+    uint64_t           ttl = EXPIRE_TTL;
+
+    STATIC_QUEUE_INIT(&queue, g_expire_items, EXPIRE_QUEUE_LEN);
+    STATIC_QUEUE_SET_TIMESTAMP(&queue, travItem_t, payload, tickClock, NULL);
+
+    uint64_t start = nowNs();
+    for (g_tick = 0; g_tick < EXPIRE_TICKS; g_tick++) {
+        for (uint32_t i = 0; i < EXPIRE_PER_TICK; i++) {
+            staticQueuePut(&queue, &item);
+        }
+        if (sweep) {
+            staticQueueForEachCtx(&queue, eraseStaleCallback, &ttl);
+        } else {
+            staticQueueExpire(&queue, g_tick, ttl, NULL, EXPIRE_QUEUE_LEN);
+        }
+    }
+    uint64_t stop = nowNs();
+
+    printf("%s %.2f ns/tick, %i items alive\n", sweep ? "ForEach + erase:" : "Expire:         ",
+           (double)(stop - start) / EXPIRE_TICKS, staticQueueGetNumItems(&queue));
+}
+
+#define AT_QUEUE_LEN (4096u)
+#define AT_LOOKUPS   (1u << 16)
+
+static travItem_t g_at_items[AT_QUEUE_LEN];
+static uint32_t   g_at_perm[AT_QUEUE_LEN];
+
+static void benchAt(staticQueue_t* queue, const char* label, uint64_t* checksum)
+{
+    staticQueueItem_t* item;
+    uint32_t           num = staticQueueGetNumItems(queue);
+
+    uint64_t start = nowNs();
+    for (uint32_t i = 0; i < AT_LOOKUPS; i++) {
+        staticQueueAt(queue, benchRand() % num, &item);
+        travItem_t* trav_item = CONTAINER_OF(item, travItem_t, node);
+        *checksum += trav_item->payload[0];
+    }
+    uint64_t stop = nowNs();
+
+    printf("%s %.2f ns/lookup\n", label, (double)(stop - start) / AT_LOOKUPS);
+}
+
+int main() {
+
+    uint32_t checksum = 0;
+
+    printf("\n=== Object cache, %u buffers of %u bytes, working set %u ===\n",
+           CACHE_ITEMS, PAYLOAD_SIZE, WORKING_SET);
+    printf("FIFO (Pop):     %.2f ns/op\n", benchObjectCache(false, &checksum));
+    printf("LIFO (PopLast): %.2f ns/op\n", benchObjectCache(true, &checksum));
+
+    staticQueue_t queue;
+    uint64_t      sum = 0;
+
+    printf("\n=== Traversal of %u scrambled items, before and after compaction ===\n", TRAVERSE_ITEMS);
+    scrambleQueue(&queue, g_trav_items, g_perm, TRAVERSE_ITEMS);
+    benchTraversal(&queue, "Scrambled:", &sum);
+
+    uint64_t start = nowNs();
+    int32_t  swaps = staticQueueCompact(&queue, swapTravItem, NULL);
+    uint64_t stop  = nowNs();
+    printf("Compact:   %.2f ms, %i swaps\n", (double)(stop - start) / 1e6, swaps);
+
+    benchTraversal(&queue, "Compacted:", &sum);
+
+    printf("\n=== Value API, 64 byte messages in batches of %u ===\n", VALUE_BATCH);
+    benchValueApi(&sum);
+
+    printf("\n=== Random access of %u items, before and after compaction ===\n", AT_QUEUE_LEN);
+    scrambleQueue(&queue, g_at_items, g_at_perm, AT_QUEUE_LEN);
+    benchAt(&queue, "Scrambled:", &sum);
+    staticQueueCompact(&queue, swapTravItem, NULL);
+    benchAt(&queue, "In order: ", &sum);
+
+    printf("\n=== TTL expiry, %u puts per tick and a ttl of %u ticks ===\n", EXPIRE_PER_TICK, EXPIRE_TTL);
+    benchExpire(true);
+    benchExpire(false);
+
+    printf("\nChecksum %u %llu\n", checksum, (unsigned long long)sum);
+    return 0;
+}
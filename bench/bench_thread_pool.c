@@ -0,0 +1,155 @@
+#include "bench_common.h"
+#include "static_thread_pool.h"
+#include <pthread.h>
+
+/**
+ * Tiny tasks per second through the static thread pool, against a naive pool with one mutex,
+ * one condition variable and one shared ring where every task is submitted and signaled alone.
+ */
+
+#define NUM_WORKERS      4
+#define TASKS_PER_WORKER 256
+#define NUM_TASKS        (1u << 20)
+#define BATCH            64
+
+static uint64_t g_sum = 0;
+
+static void tinyTask(void* arg)
+{
+    __atomic_add_fetch(&g_sum, (uint64_t)(uintptr_t)arg, __ATOMIC_RELAXED);
+}
+
+// ===== Naive pool =====
+
+#define NAIVE_LEN (NUM_WORKERS * TASKS_PER_WORKER)
+
+typedef struct {
+    staticPoolTaskFn_t fn;
+    void*              arg;
+} naiveTask_t;
+
+typedef struct {
+    naiveTask_t     ring[NAIVE_LEN];
+    uint32_t        head;
+    uint32_t        tail;
+    uint32_t        pending;
+    bool            stop;
+    pthread_mutex_t mutex;
+    pthread_cond_t  not_empty;
+    pthread_cond_t  not_full;
+    pthread_cond_t  idle;
+    pthread_t       threads[NUM_WORKERS];
+} naivePool_t;
+
+static void* naiveWorker(void* arg)
+{
+    naivePool_t* pool = arg;
+
+    pthread_mutex_lock(&pool->mutex);
+    for (;;) {
+        while (pool->head == pool->tail && !pool->stop) {
+            pthread_cond_wait(&pool->not_empty, &pool->mutex);
+        }
+        if (pool->head == pool->tail) {
+            break;
+        }
+
+        naiveTask_t task = pool->ring[pool->tail++ % NAIVE_LEN];
+        pthread_cond_signal(&pool->not_full);
+        pthread_mutex_unlock(&pool->mutex);
+
+        task.fn(task.arg);
+
+        pthread_mutex_lock(&pool->mutex);
+        if (--pool->pending == 0) {
+            pthread_cond_broadcast(&pool->idle);
+        }
+    }
+    pthread_mutex_unlock(&pool->mutex);
+
+    return NULL;
+}
+
+static void naiveSubmit(naivePool_t* pool, staticPoolTaskFn_t fn, void* arg)
+{
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->head - pool->tail == NAIVE_LEN) {
+        pthread_cond_wait(&pool->not_full, &pool->mutex);
+    }
+    pool->ring[pool->head++ % NAIVE_LEN] = (naiveTask_t){fn, arg};
+    pool->pending++;
+    pthread_cond_signal(&pool->not_empty);
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+static double benchNaive(void)
+{
+    static naivePool_t pool;
+    pthread_mutex_init(&pool.mutex, NULL);
+    pthread_cond_init(&pool.not_empty, NULL);
+    pthread_cond_init(&pool.not_full, NULL);
+    pthread_cond_init(&pool.idle, NULL);
+    for (uint32_t i = 0; i < NUM_WORKERS; i++) {
+        pthread_create(&pool.threads[i], NULL, naiveWorker, &pool);
+    }
+
+    uint64_t start = nowNs();
+    for (uint32_t i = 0; i < NUM_TASKS; i++) {
+        naiveSubmit(&pool, tinyTask, (void*)(uintptr_t)1);
+    }
+    pthread_mutex_lock(&pool.mutex);
+    while (pool.pending != 0) {
+        pthread_cond_wait(&pool.idle, &pool.mutex);
+    }
+    pool.stop = true;
+    pthread_cond_broadcast(&pool.not_empty);
+    pthread_mutex_unlock(&pool.mutex);
+    uint64_t stop = nowNs();
+
+    for (uint32_t i = 0; i < NUM_WORKERS; i++) {
+        pthread_join(pool.threads[i], NULL);
+    }
+
+    return NUM_TASKS * 1e9 / (stop - start);
+}
+
+static double benchStatic(uint32_t batch)
+{
+    static staticPoolTask_t         tasks[NUM_WORKERS * TASKS_PER_WORKER];
+    static staticThreadPoolWorker_t workers[NUM_WORKERS];
+    static staticThreadPool_t       pool;
+    void*                           args[BATCH];
+
+    for (uint32_t i = 0; i < BATCH; i++) {
+        args[i] = (void*)(uintptr_t)1;
+    }
+    staticThreadPoolInit(&pool, workers, NUM_WORKERS, tasks, TASKS_PER_WORKER);
+
+    uint64_t start     = nowNs();
+    uint32_t submitted = 0;
+    while (submitted < NUM_TASKS) {
+        int32_t result = staticThreadPoolSubmitMany(&pool, tinyTask, args, batch);
+        if (result > 0) {
+            submitted += result;
+        } else {
+            sched_yield();
+        }
+    }
+    staticThreadPoolWaitAll(&pool);
+    uint64_t stop = nowNs();
+
+    staticThreadPoolDestroy(&pool);
+
+    return NUM_TASKS * 1e9 / (stop - start);
+}
+
+int main() {
+
+    printf("\n=== Tiny tasks, %u workers ===\n", NUM_WORKERS);
+    printf("Naive mutex+condvar:   %.2f Mtasks/s\n", benchNaive() / 1e6);
+    printf("Static pool, batch 1:  %.2f Mtasks/s\n", benchStatic(1) / 1e6);
+    printf("Static pool, batch %u: %.2f Mtasks/s\n", BATCH, benchStatic(BATCH) / 1e6);
+    printf("\nChecksum %llu\n", (unsigned long long)g_sum);
+
+    return 0;
+}
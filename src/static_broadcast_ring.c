@@ -0,0 +1,160 @@
+/**
+ * @file:       static_broadcast_ring.c
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Implementation of static multicast ring module
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "static_broadcast_ring.h"
+
+int32_t staticBroadcastRingInit(staticBroadcastRing_t* ring,
+                                void*                  slots,
+                                uint32_t               num_slots,
+                                uint32_t               slot_size)
+{
+    if (ring == NULL || slots == NULL || num_slots == 0 || (num_slots & (num_slots - 1)) != 0) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    ring->slots      = (uint8_t*)slots;
+    ring->slot_size  = slot_size;
+    ring->num_slots  = num_slots;
+    ring->mask       = num_slots - 1;
+    ring->cursor     = 0;
+    ring->claimed    = 0;
+    ring->gate_cache = 0;
+    ring->consumers  = NULL;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticBroadcastRingAddConsumer(staticBroadcastRing_t* ring, staticBroadcastConsumer_t* consumer)
+{
+    if (ring == NULL || consumer == NULL) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    consumer->sequence = __atomic_load_n(&ring->cursor, __ATOMIC_ACQUIRE);
+    consumer->next     = ring->consumers;
+    ring->consumers    = consumer;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+// Find the sequence of the slowest consumer, the producer can not pass it
+static uint32_t slowestConsumer(staticBroadcastRing_t* ring)
+{
+    uint32_t                   slowest  = ring->claimed;
+    staticBroadcastConsumer_t* consumer = ring->consumers;
+
+    while (consumer != NULL) {
+        uint32_t sequence = __atomic_load_n(&consumer->sequence, __ATOMIC_ACQUIRE);
+        // Sequences wrap, compare the distance behind the producer
+        if (ring->claimed - sequence > ring->claimed - slowest) {
+            slowest = sequence;
+        }
+        consumer = consumer->next;
+    }
+
+    return slowest;
+}
+
+int32_t staticBroadcastRingClaim(staticBroadcastRing_t* ring, void** slot)
+{
+    // Only scan the consumers when the cached gate says the ring is full
+    if (ring->claimed - ring->gate_cache >= ring->num_slots) {
+        ring->gate_cache = slowestConsumer(ring);
+        if (ring->claimed - ring->gate_cache >= ring->num_slots) {
+            return STATIC_QUEUE_FULL;
+        }
+    }
+
+    *slot = ring->slots + (size_t)(ring->claimed & ring->mask) * ring->slot_size;
+    ring->claimed++;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticBroadcastRingPublish(staticBroadcastRing_t* ring)
+{
+    // Release store, so the slot contents are visible before the cursor
+    __atomic_store_n(&ring->cursor, ring->claimed, __ATOMIC_RELEASE);
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+uint32_t staticBroadcastRingAvailable(staticBroadcastRing_t* ring, staticBroadcastConsumer_t* consumer)
+{
+    return __atomic_load_n(&ring->cursor, __ATOMIC_ACQUIRE) - consumer->sequence;
+}
+
+int32_t staticBroadcastRingPeek(staticBroadcastRing_t* ring, staticBroadcastConsumer_t* consumer, void** slot)
+{
+    if (staticBroadcastRingAvailable(ring, consumer) == 0) {
+        return STATIC_QUEUE_EMPTY;
+    }
+
+    *slot = ring->slots + (size_t)(consumer->sequence & ring->mask) * ring->slot_size;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticBroadcastRingPeekBatch(staticBroadcastRing_t*     ring,
+                                     staticBroadcastConsumer_t* consumer,
+                                     void**                     first,
+                                     uint32_t                   max_items)
+{
+    uint32_t available = staticBroadcastRingAvailable(ring, consumer);
+    if (available == 0) {
+        return STATIC_QUEUE_EMPTY;
+    }
+
+    // Only return the items that are contiguous in the slot array
+    uint32_t index = consumer->sequence & ring->mask;
+    if (available > ring->num_slots - index) {
+        available = ring->num_slots - index;
+    }
+    if (available > max_items) {
+        available = max_items;
+    }
+
+    *first = ring->slots + (size_t)index * ring->slot_size;
+
+    return available;
+}
+
+int32_t staticBroadcastRingRelease(staticBroadcastRing_t*     ring,
+                                   staticBroadcastConsumer_t* consumer,
+                                   uint32_t                   num_items)
+{
+    if (num_items > staticBroadcastRingAvailable(ring, consumer)) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    // Release store, so the reads of the slots are done before the producer may reuse them
+    __atomic_store_n(&consumer->sequence, consumer->sequence + num_items, __ATOMIC_RELEASE);
+
+    return STATIC_QUEUE_SUCCESS;
+}
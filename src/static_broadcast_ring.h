@@ -0,0 +1,174 @@
+/**
+ * @file:       static_broadcast_ring.h
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Header file for static multicast ring module
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#ifndef INC_STATIC_BROADCAST_RING_H_
+#define INC_STATIC_BROADCAST_RING_H_
+
+#include "static_queue.h"
+
+/**
+ * The static broadcast ring delivers every item to several independent consumers without copying,
+ * in the style of the LMAX Disruptor. There is one producer, each consumer keeps its own sequence
+ * cursor and reads the items in place. The producer is gated by the slowest consumer.
+ *
+ * Allocate an array of slots, the number of slots must be a power of two
+ *     myItem_t my_slots[64];
+ *
+ * Init the ring and add the consumers, these must be added before the producer starts
+ *     staticBroadcastRing_t     my_ring = {0};
+ *     staticBroadcastConsumer_t log_consumer, metrics_consumer;
+ *     STATIC_BROADCAST_RING_INIT(&my_ring, my_slots);
+ *     staticBroadcastRingAddConsumer(&my_ring, &log_consumer);
+ *     staticBroadcastRingAddConsumer(&my_ring, &metrics_consumer);
+ *
+ * Producer, claim a slot, fill it and publish:
+ *
+ *   void* slot;
+ *   if (staticBroadcastRingClaim(&my_ring, &slot) == STATIC_QUEUE_SUCCESS) {
+ *       ((myItem_t*)slot)->my_data = 1337;
+ *       staticBroadcastRingPublish(&my_ring);
+ *   }
+ *
+ * Consumer, catch up on everything published since the last call and release it:
+ *
+ *   void*   first;
+ *   int32_t num = staticBroadcastRingPeekBatch(&my_ring, &log_consumer, &first, 32);
+ *   if (num > 0) {
+ *       for (int32_t i = 0; i < num; i++) {
+ *           log(((myItem_t*)first)[i].my_data);
+ *       }
+ *       staticBroadcastRingRelease(&my_ring, &log_consumer, (uint32_t)num);
+ *   }
+ *
+ * The producer and each consumer may run on their own thread, the sequences are published with
+ * release/acquire ordering. A single consumer must not be shared between threads.
+ */
+
+typedef struct staticBroadcastConsumer staticBroadcastConsumer_t;
+
+struct staticBroadcastConsumer {
+    uint32_t                   sequence; // Next sequence to read
+    staticBroadcastConsumer_t* next;
+};
+
+typedef struct {
+    uint8_t*                   slots;
+    uint32_t                   slot_size;
+    uint32_t                   num_slots;
+    uint32_t                   mask;
+    uint32_t                   cursor;     // Next sequence to publish, written by the producer
+    uint32_t                   claimed;    // Next sequence to claim, producer private
+    uint32_t                   gate_cache; // Last known slowest consumer sequence, producer private
+    staticBroadcastConsumer_t* consumers;
+} staticBroadcastRing_t;
+
+/**
+ * Initialize a static broadcast ring
+ * Input: Ring instance
+ * Input: Pointer to the first slot
+ * Input: Number of slots, must be a power of two
+ * Input: The sizeof a slot
+ * Returns: queueErr_t
+ */
+int32_t staticBroadcastRingInit(staticBroadcastRing_t* ring,
+                                void*                  slots,
+                                uint32_t               num_slots,
+                                uint32_t               slot_size);
+
+/**
+ * Add a consumer to the ring, it will see every item published after this call
+ * Input: Ring instance
+ * Input: Consumer instance
+ * Returns: queueErr_t
+ */
+int32_t staticBroadcastRingAddConsumer(staticBroadcastRing_t* ring, staticBroadcastConsumer_t* consumer);
+
+/**
+ * Claim the next slot to write to, it is not visible to the consumers until published
+ * Input: Ring instance
+ * Input: This pointer will be populated with the slot to write data to
+ * Returns: queueErr_t, STATIC_QUEUE_FULL if the slowest consumer has not released the slot
+ */
+int32_t staticBroadcastRingClaim(staticBroadcastRing_t* ring, void** slot);
+
+/**
+ * Publish all claimed slots to the consumers
+ * Input: Ring instance
+ * Returns: queueErr_t
+ */
+int32_t staticBroadcastRingPublish(staticBroadcastRing_t* ring);
+
+/**
+ * Get the next item for a consumer, but do not release it
+ * Input: Ring instance
+ * Input: Consumer instance
+ * Input: This pointer will be populated with the item
+ * Returns: queueErr_t
+ */
+int32_t staticBroadcastRingPeek(staticBroadcastRing_t* ring, staticBroadcastConsumer_t* consumer, void** slot);
+
+/**
+ * Get all items available to a consumer, up to the end of the slot array
+ * Input: Ring instance
+ * Input: Consumer instance
+ * Input: This pointer will be populated with the first item, the rest follow in the array
+ * Input: Max number of items to return
+ * Returns: Number of items available, or negative error code
+ */
+int32_t staticBroadcastRingPeekBatch(staticBroadcastRing_t*     ring,
+                                     staticBroadcastConsumer_t* consumer,
+                                     void**                     first,
+                                     uint32_t                   max_items);
+
+/**
+ * Release items for a consumer, the slots can be reused once all consumers have released them
+ * Input: Ring instance
+ * Input: Consumer instance
+ * Input: Number of items to release
+ * Returns: queueErr_t
+ */
+int32_t staticBroadcastRingRelease(staticBroadcastRing_t*     ring,
+                                   staticBroadcastConsumer_t* consumer,
+                                   uint32_t                   num_items);
+
+/**
+ * Get the number of published items a consumer has not yet released
+ * Input: Ring instance
+ * Input: Consumer instance
+ * Returns: Number of items
+ */
+uint32_t staticBroadcastRingAvailable(staticBroadcastRing_t* ring, staticBroadcastConsumer_t* consumer);
+
+/**
+ * This is a macro that makes it more safe to initialize a ring from an array
+ */
+#define STATIC_BROADCAST_RING_INIT(ring, array) \
+    staticBroadcastRingInit((ring), (array), sizeof(array) / sizeof((array)[0]), sizeof((array)[0]))
+
+#endif /* INC_STATIC_BROADCAST_RING_H_ */
@@ -0,0 +1,185 @@
+/**
+ * @file:       static_byte_ring.c
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Implementation of static variable length byte ring module
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include <string.h>
+#include "static_byte_ring.h"
+
+static inline uint32_t recordSize(uint32_t len)
+{
+    uint32_t size = STATIC_BYTE_RING_HEADER_SIZE + len;
+    return (size + STATIC_BYTE_RING_ALIGN - 1) & ~(STATIC_BYTE_RING_ALIGN - 1);
+}
+
+int32_t staticByteRingInit(staticByteRing_t* ring, void* buffer, uint32_t size)
+{
+    if (ring == NULL || buffer == NULL || size < STATIC_BYTE_RING_HEADER_SIZE) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    ring->buffer      = (uint8_t*)buffer;
+    // Only whole aligned records can be stored
+    ring->size        = size & ~(STATIC_BYTE_RING_ALIGN - 1);
+    ring->head        = 0;
+    ring->tail        = 0;
+    ring->wrap        = ring->size;
+    ring->num_records = 0;
+    ring->reserve_pos = 0;
+    ring->reserve_len = 0;
+    ring->reserved    = false;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticByteRingReserve(staticByteRing_t* ring, uint32_t len, uint8_t** data)
+{
+    if (ring->reserved || len > ring->size) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    uint32_t need = recordSize(len);
+    if (need > ring->size) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    // Restart from the beginning of the buffer when empty, this gives the largest contiguous region
+    if (ring->num_records == 0) {
+        ring->head = 0;
+        ring->tail = 0;
+        ring->wrap = ring->size;
+    }
+
+    uint32_t pos;
+    if (ring->num_records == 0 || ring->head > ring->tail) {
+        // Not wrapped, free space is at the end and before the tail
+        if (need <= ring->size - ring->head) {
+            pos = ring->head;
+        } else if (need <= ring->tail) {
+            pos = 0;
+        } else {
+            return STATIC_QUEUE_FULL;
+        }
+    } else {
+        // Wrapped, free space is between head and tail
+        if (need <= ring->tail - ring->head) {
+            pos = ring->head;
+        } else {
+            return STATIC_QUEUE_FULL;
+        }
+    }
+
+    ring->reserve_pos = pos;
+    ring->reserve_len = len;
+    ring->reserved    = true;
+    *data             = ring->buffer + pos + STATIC_BYTE_RING_HEADER_SIZE;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticByteRingCommit(staticByteRing_t* ring, uint32_t len)
+{
+    if (!ring->reserved || len > ring->reserve_len) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    uint32_t header = len;
+    memcpy(ring->buffer + ring->reserve_pos, &header, sizeof(header));
+
+    // The reservation was placed at the start, mark where the valid data ends
+    if (ring->reserve_pos != ring->head) {
+        if (ring->num_records == 0) {
+            // The reader has already caught up, so there is nothing left to skip
+            ring->tail = 0;
+        } else {
+            ring->wrap = ring->head;
+        }
+    }
+
+    ring->head      = ring->reserve_pos + recordSize(len);
+    ring->reserved  = false;
+    ring->num_records++;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticByteRingCancel(staticByteRing_t* ring)
+{
+    if (!ring->reserved) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    ring->reserved = false;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticByteRingPeek(staticByteRing_t* ring, uint8_t** data, uint32_t* len)
+{
+    if (ring->num_records == 0) {
+        return STATIC_QUEUE_EMPTY;
+    }
+
+    uint32_t header;
+    memcpy(&header, ring->buffer + ring->tail, sizeof(header));
+
+    *data = ring->buffer + ring->tail + STATIC_BYTE_RING_HEADER_SIZE;
+    *len  = header;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticByteRingRelease(staticByteRing_t* ring)
+{
+    if (ring->num_records == 0) {
+        return STATIC_QUEUE_EMPTY;
+    }
+
+    uint32_t header;
+    memcpy(&header, ring->buffer + ring->tail, sizeof(header));
+
+    ring->tail += recordSize(header);
+    ring->num_records--;
+
+    // Skip the unused space at the end if the writer has wrapped
+    if (ring->tail == ring->wrap) {
+        ring->tail = 0;
+        ring->wrap = ring->size;
+    }
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+bool staticByteRingEmpty(staticByteRing_t* ring)
+{
+    return ring->num_records == 0;
+}
+
+uint32_t staticByteRingGetNumRecords(staticByteRing_t* ring)
+{
+    return ring->num_records;
+}
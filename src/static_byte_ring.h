@@ -0,0 +1,156 @@
+/**
+ * @file:       static_byte_ring.h
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Header file for static variable length byte ring module
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#ifndef INC_STATIC_BYTE_RING_H_
+#define INC_STATIC_BYTE_RING_H_
+
+#include "static_queue.h"
+
+/**
+ * The static byte ring is a companion to the static queue for variable sized records, such as
+ * log lines or packets. It operates on a caller provided byte buffer, no padding to a maximum
+ * record size is needed.
+ *
+ * Allocate a buffer, it should be 4 byte aligned
+ *     static uint32_t my_buffer[256];
+ *
+ * Create an instance of the staticByteRing_t and init it
+ *     staticByteRing_t my_ring = {0};
+ *     STATIC_BYTE_RING_INIT(&my_ring, my_buffer);
+ *
+ * To write, reserve a contiguous region, fill it in place and commit the number of bytes used:
+ *
+ *   uint8_t* data;
+ *   if (staticByteRingReserve(&my_ring, 64, &data) == STATIC_QUEUE_SUCCESS) {
+ *       uint32_t len = snprintf((char*)data, 64, "Hello %u", 1337);
+ *       staticByteRingCommit(&my_ring, len);
+ *   }
+ *
+ * To read, peek the oldest record in place and release it when done:
+ *
+ *   uint8_t* data;
+ *   uint32_t len;
+ *   if (staticByteRingPeek(&my_ring, &data, &len) == STATIC_QUEUE_SUCCESS) {
+ *       fwrite(data, 1, len, stdout);
+ *       staticByteRingRelease(&my_ring);
+ *   }
+ *
+ * Records are never split across the end of the buffer. If a reservation does not fit in the
+ * remaining space at the end, it is placed at the start of the buffer and the tail space is
+ * skipped until the reader has passed it.
+ *
+ * Each record costs STATIC_BYTE_RING_HEADER_SIZE bytes of overhead and is padded to a multiple
+ * of STATIC_BYTE_RING_ALIGN, so every payload pointer is 4 byte aligned if the buffer is.
+ */
+
+#define STATIC_BYTE_RING_HEADER_SIZE (sizeof(uint32_t))
+#define STATIC_BYTE_RING_ALIGN       (4u)
+
+typedef struct {
+    uint8_t* buffer;
+    uint32_t size;
+    uint32_t head;        // Write offset, one past the newest record
+    uint32_t tail;        // Read offset, the oldest record
+    uint32_t wrap;        // End of valid data before the writer wrapped, size if not wrapped
+    uint32_t num_records;
+    uint32_t reserve_pos; // Offset of the pending reservation
+    uint32_t reserve_len; // Payload length of the pending reservation, 0 if none
+    bool     reserved;
+} staticByteRing_t;
+
+/**
+ * Initialize a static byte ring
+ * Input: Ring instance
+ * Input: Pointer to the buffer, should be 4 byte aligned
+ * Input: Size of the buffer in bytes
+ * Returns: queueErr_t
+ */
+int32_t staticByteRingInit(staticByteRing_t* ring, void* buffer, uint32_t size);
+
+/**
+ * Reserve a contiguous region to write a record to, the region is not visible to the reader
+ * until it is committed. Only one reservation can be pending at a time.
+ * Input: Ring instance
+ * Input: Maximum number of bytes that will be written
+ * Input: This pointer will be populated with the region to write data to
+ * Returns: queueErr_t
+ */
+int32_t staticByteRingReserve(staticByteRing_t* ring, uint32_t len, uint8_t** data);
+
+/**
+ * Commit the pending reservation and make it visible to the reader
+ * Input: Ring instance
+ * Input: Number of bytes actually written, must not exceed the reserved length
+ * Returns: queueErr_t
+ */
+int32_t staticByteRingCommit(staticByteRing_t* ring, uint32_t len);
+
+/**
+ * Drop the pending reservation without publishing anything
+ * Input: Ring instance
+ * Returns: queueErr_t
+ */
+int32_t staticByteRingCancel(staticByteRing_t* ring);
+
+/**
+ * Get the oldest record in the ring, but do not remove it
+ * Input: Ring instance
+ * Input: This pointer will be populated with the record data
+ * Input: This pointer will be populated with the record length
+ * Returns: queueErr_t
+ */
+int32_t staticByteRingPeek(staticByteRing_t* ring, uint8_t** data, uint32_t* len);
+
+/**
+ * Remove the oldest record from the ring, the memory returned by peek is reused after this
+ * Input: Ring instance
+ * Returns: queueErr_t
+ */
+int32_t staticByteRingRelease(staticByteRing_t* ring);
+
+/**
+ * Check it the ring is empty
+ * Input: Ring instance
+ * Returns: true if empty
+ */
+bool staticByteRingEmpty(staticByteRing_t* ring);
+
+/**
+ * Get the number of committed records in the ring
+ * Input: Ring instance
+ * Returns: Number of records
+ */
+uint32_t staticByteRingGetNumRecords(staticByteRing_t* ring);
+
+/**
+ * This is a macro that makes it more safe to initialize a ring from an array
+ */
+#define STATIC_BYTE_RING_INIT(ring, array) \
+    staticByteRingInit((ring), (array), sizeof(array))
+
+#endif /* INC_STATIC_BYTE_RING_H_ */
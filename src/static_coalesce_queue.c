@@ -0,0 +1,145 @@
+/**
+ * @file:       static_coalesce_queue.c
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Implementation of static coalescing queue module
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "static_coalesce_queue.h"
+
+int32_t staticCoalesceQueueInit(staticCoalesceQueue_t* coalesce_queue,
+                                uint32_t               queue_size,
+                                uint32_t               node_size,
+                                staticCoalesceItem_t*  first_item,
+                                staticCoalesceItem_t** index,
+                                uint32_t               index_size,
+                                bool                   refresh)
+{
+    if (coalesce_queue == NULL || first_item == NULL ||
+        staticKeyIndexInit(&coalesce_queue->index, index, index_size, queue_size) != STATIC_QUEUE_SUCCESS) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    coalesce_queue->refresh = refresh;
+
+    return staticQueueInit(&coalesce_queue->queue, queue_size, node_size, &first_item->node);
+}
+
+int32_t staticCoalesceQueuePut(staticCoalesceQueue_t* coalesce_queue,
+                               uint64_t               key,
+                               staticCoalesceItem_t** next_item,
+                               bool*                  merged)
+{
+    uint32_t              slot  = staticKeyIndexFind(&coalesce_queue->index, key);
+    staticCoalesceItem_t* entry = coalesce_queue->index.slots[slot];
+
+    if (entry != NULL) {
+        if (coalesce_queue->refresh) {
+            staticQueueMoveLast(&coalesce_queue->queue, &entry->node);
+        }
+        if (merged != NULL) {
+            *merged = true;
+        }
+        *next_item = entry;
+        return STATIC_QUEUE_SUCCESS;
+    }
+
+    staticQueueItem_t* node;
+    int32_t            result = staticQueuePut(&coalesce_queue->queue, &node);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        return result;
+    }
+
+    entry                             = CONTAINER_OF(node, staticCoalesceItem_t, node);
+    entry->key                        = key;
+    coalesce_queue->index.slots[slot] = entry;
+    *next_item                        = entry;
+    if (merged != NULL) {
+        *merged = false;
+    }
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticCoalesceQueuePop(staticCoalesceQueue_t* coalesce_queue, staticCoalesceItem_t** pop_item)
+{
+    staticQueueItem_t* node;
+
+    int32_t result = staticQueuePop(&coalesce_queue->queue, &node);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        return result;
+    }
+
+    *pop_item = CONTAINER_OF(node, staticCoalesceItem_t, node);
+    staticKeyIndexDelete(&coalesce_queue->index, staticKeyIndexFind(&coalesce_queue->index, (*pop_item)->key));
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticCoalesceQueuePeak(staticCoalesceQueue_t* coalesce_queue, staticCoalesceItem_t** peak_item)
+{
+    staticQueueItem_t* node;
+
+    int32_t result = staticQueuePeak(&coalesce_queue->queue, &node);
+    if (result == STATIC_QUEUE_SUCCESS) {
+        *peak_item = CONTAINER_OF(node, staticCoalesceItem_t, node);
+    }
+
+    return result;
+}
+
+int32_t staticCoalesceQueueFind(staticCoalesceQueue_t* coalesce_queue,
+                                uint64_t               key,
+                                staticCoalesceItem_t** found_item)
+{
+    staticCoalesceItem_t* entry = coalesce_queue->index.slots[staticKeyIndexFind(&coalesce_queue->index, key)];
+    if (entry == NULL) {
+        return STATIC_QUEUE_NOT_IN_QUEUE;
+    }
+
+    *found_item = entry;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticCoalesceQueueErase(staticCoalesceQueue_t* coalesce_queue, uint64_t key)
+{
+    uint32_t              slot  = staticKeyIndexFind(&coalesce_queue->index, key);
+    staticCoalesceItem_t* entry = coalesce_queue->index.slots[slot];
+    if (entry == NULL) {
+        return STATIC_QUEUE_NOT_IN_QUEUE;
+    }
+
+    staticKeyIndexDelete(&coalesce_queue->index, slot);
+
+    staticQueueItem_t* node;
+    staticQueueMoveLast(&coalesce_queue->queue, &entry->node);
+    return staticQueuePopLast(&coalesce_queue->queue, &node);
+}
+
+bool staticCoalesceQueueEmpty(staticCoalesceQueue_t* coalesce_queue)
+{
+    return staticQueueEmpty(&coalesce_queue->queue);
+}
@@ -0,0 +1,144 @@
+/**
+ * @file:       static_coalesce_queue.h
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Header file for static coalescing queue module
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#ifndef INC_STATIC_COALESCE_QUEUE_H_
+#define INC_STATIC_COALESCE_QUEUE_H_
+
+#include "static_key_index.h"
+
+/**
+ * A static queue that holds at most one item per 64 bit key. A put whose key is already queued
+ * returns the queued item so it can be updated in place instead of taking a new slot. The item
+ * keeps its position, or moves to the end if the queue is set up to refresh positions.
+ * An open addressed hash index maps keys to queued items, so puts and pops stay O(1).
+ *
+ * Embed a staticCoalesceItem_t named entry in the item struct, the index is an array of pointers
+ * with a power of two size larger than the queue size
+ *     typedef struct {
+ *         uint32_t             my_state;
+ *         staticCoalesceItem_t entry;
+ *     } myItem_t;
+ *     myItem_t               my_array[QUEUE_SIZE];
+ *     staticCoalesceItem_t*  my_index[2 * QUEUE_SIZE];
+ *     staticCoalesceQueue_t  my_queue;
+ *     STATIC_COALESCE_QUEUE_INIT(&my_queue, my_array, QUEUE_SIZE, my_index, false);
+ *
+ * All puts, pops and erases must go through the coalescing queue to keep the index in sync.
+ */
+
+typedef staticKeyItem_t staticCoalesceItem_t;
+
+typedef struct {
+    staticQueue_t          queue;
+    staticKeyIndex_t       index;
+    bool                   refresh; // Move a merged item to the end of the queue
+} staticCoalesceQueue_t;
+
+/**
+ * Initialize a coalescing queue
+ * Input: Queue instance
+ * Input: Number of items in the queue
+ * Input: Size of each item, including the staticCoalesceItem_t
+ * Input: Pointer to the staticCoalesceItem_t of the first item
+ * Input: Index array, it is cleared here
+ * Input: Number of index slots, a power of two larger than the number of items
+ * Input: true to move a merged item to the end of the queue, false to keep its position
+ * Returns: queueErr_t
+ */
+int32_t staticCoalesceQueueInit(staticCoalesceQueue_t* coalesce_queue,
+                                uint32_t               queue_size,
+                                uint32_t               node_size,
+                                staticCoalesceItem_t*  first_item,
+                                staticCoalesceItem_t** index,
+                                uint32_t               index_size,
+                                bool                   refresh);
+
+/**
+ * Put an item for a key, if the key is already queued that item is returned instead
+ * Input: Queue instance
+ * Input: Key of the item
+ * Input: This pointer wil be populated with the pointer to the relevant item to write data to
+ * Input: Set to true if the item was already queued, may be NULL
+ * Returns: queueErr_t
+ */
+int32_t staticCoalesceQueuePut(staticCoalesceQueue_t* coalesce_queue,
+                               uint64_t               key,
+                               staticCoalesceItem_t** next_item,
+                               bool*                  merged);
+
+/**
+ * Get and remove the first item from the queue
+ * Input: Queue instance
+ * Input: This pointer will be populated with the pop'ed item
+ * Returns: queueErr_t
+ */
+int32_t staticCoalesceQueuePop(staticCoalesceQueue_t* coalesce_queue, staticCoalesceItem_t** pop_item);
+
+/**
+ * Get the first item from the queue, but do not remove it
+ * Input: Queue instance
+ * Input: This pointer will be populated with the item
+ * Returns: queueErr_t
+ */
+int32_t staticCoalesceQueuePeak(staticCoalesceQueue_t* coalesce_queue, staticCoalesceItem_t** peak_item);
+
+/**
+ * Find the queued item for a key
+ * Input: Queue instance
+ * Input: Key to look up
+ * Input: This pointer will be populated with the item
+ * Returns: queueErr_t, STATIC_QUEUE_NOT_IN_QUEUE if the key is not queued
+ */
+int32_t staticCoalesceQueueFind(staticCoalesceQueue_t* coalesce_queue,
+                                uint64_t               key,
+                                staticCoalesceItem_t** found_item);
+
+/**
+ * Erase the queued item for a key
+ * Input: Queue instance
+ * Input: Key to erase
+ * Returns: queueErr_t, STATIC_QUEUE_NOT_IN_QUEUE if the key is not queued
+ */
+int32_t staticCoalesceQueueErase(staticCoalesceQueue_t* coalesce_queue, uint64_t key);
+
+/**
+ * Check if the queue is empty
+ * Input: Queue instance
+ * Returns: true if empty
+ */
+bool staticCoalesceQueueEmpty(staticCoalesceQueue_t* coalesce_queue);
+
+/**
+ * This is a macro that makes it more safe to initialize a coalescing queue
+ */
+#define STATIC_COALESCE_QUEUE_INIT(coalesce_queue, list, size, index_array, refresh) \
+    staticCoalesceQueueInit((coalesce_queue), (size), sizeof((list)[0]), &list->entry, (index_array), \
+                            sizeof(index_array) / sizeof((index_array)[0]), (refresh))
+
+#endif /* INC_STATIC_COALESCE_QUEUE_H_ */
@@ -0,0 +1,285 @@
+/**
+ * @file:       static_delay_queue.c
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Implementation of static delay queue module
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "static_delay_queue.h"
+
+#define BUCKET_BIT(bucket) (0x80000000u >> (bucket))
+
+static inline uint32_t countTrailingZeros(uint32_t value)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(value);
+#else
+    uint32_t count = 0;
+    while (!(value & 1u)) {
+        value >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+static inline uint64_t deadlineOf(staticQueueItem_t* node)
+{
+    staticDelayItem_t* item = CONTAINER_OF(node, staticDelayItem_t, node);
+    return item->deadline;
+}
+
+static inline uint32_t bucketOf(staticDelayQueue_t* delay_queue, uint64_t deadline)
+{
+    if (deadline <= delay_queue->base) {
+        return 0;
+    }
+
+    uint64_t bucket = (deadline - delay_queue->base) >> delay_queue->shift;
+    return bucket < STATIC_DELAY_QUEUE_BUCKETS ? (uint32_t)bucket : STATIC_DELAY_QUEUE_BUCKETS - 1;
+}
+
+// Remove a node from the index, must be called before the node is unlinked
+static inline void unindex(staticDelayQueue_t* delay_queue, staticQueueItem_t* node)
+{
+    uint32_t bucket = bucketOf(delay_queue, deadlineOf(node));
+    if (delay_queue->bucket_last[bucket] != node) {
+        return;
+    }
+
+    staticQueueItem_t* last = node->last;
+    if (node != delay_queue->queue.tail && bucketOf(delay_queue, deadlineOf(last)) == bucket) {
+        delay_queue->bucket_last[bucket] = last;
+    } else {
+        delay_queue->bucket_last[bucket] = NULL;
+        delay_queue->non_empty &= ~BUCKET_BIT(bucket);
+    }
+}
+
+// Find the last node with a deadline <= the given deadline, NULL if the new item goes first
+static staticQueueItem_t* findPosition(staticDelayQueue_t* delay_queue, uint64_t deadline, uint32_t bucket)
+{
+    // Buckets at or before this one, the lowest set bit is the closest bucket
+    uint32_t candidates = delay_queue->non_empty & (0xFFFFFFFFu << (31 - bucket));
+    if (candidates == 0) {
+        return NULL;
+    }
+
+    // Only the closest bucket can hold deadlines after this one, every earlier bucket ends before it
+    staticQueueItem_t* node = delay_queue->bucket_last[31 - countTrailingZeros(candidates)];
+    while (deadlineOf(node) > deadline) {
+        if (node == delay_queue->queue.tail) {
+            return NULL;
+        }
+        node = node->last;
+    }
+
+    return node;
+}
+
+// Index the items leaving the last bucket, which holds every deadline past the others
+static void splitLastBucket(staticDelayQueue_t* delay_queue)
+{
+    const uint32_t     last_bucket = STATIC_DELAY_QUEUE_BUCKETS - 1;
+    staticQueueItem_t* overflow    = delay_queue->bucket_last[last_bucket];
+    if (overflow == NULL) {
+        return;
+    }
+
+    // The last bucket starts after the last item of the closest bucket before it
+    uint32_t           earlier = delay_queue->non_empty & ~BUCKET_BIT(last_bucket);
+    staticQueueItem_t* node    = earlier != 0 ? delay_queue->bucket_last[31 - countTrailingZeros(earlier)]->next :
+                                                delay_queue->queue.tail;
+
+    // Sorted, so only the items that now fall in range are visited, each of them once
+    for (;;) {
+        uint32_t bucket = bucketOf(delay_queue, deadlineOf(node));
+        if (bucket == last_bucket) {
+            return;
+        }
+
+        delay_queue->bucket_last[bucket] = node;
+        delay_queue->non_empty |= BUCKET_BIT(bucket);
+
+        if (node == overflow) {
+            delay_queue->bucket_last[last_bucket] = NULL;
+            delay_queue->non_empty &= ~BUCKET_BIT(last_bucket);
+            return;
+        }
+        node = node->next;
+    }
+}
+
+/**
+ * Rotate the buckets like a timing wheel once bucket 0 is empty, so that the earliest deadline
+ * is in bucket 0 again. Without this a queue that never runs empty keeps its first base and
+ * every later deadline ends up in the last bucket.
+ */
+static void advanceBase(staticDelayQueue_t* delay_queue)
+{
+    if (staticQueueEmpty(&delay_queue->queue)) {
+        return;
+    }
+
+    uint64_t front = deadlineOf(delay_queue->queue.tail);
+    if (front <= delay_queue->base) {
+        return;
+    }
+
+    uint64_t steps = (front - delay_queue->base) >> delay_queue->shift;
+    if (steps == 0) {
+        return;
+    }
+
+    // The front item is the earliest, so the buckets before its bucket are empty
+    const uint32_t last_bucket = STATIC_DELAY_QUEUE_BUCKETS - 1;
+    uint32_t       keep        = delay_queue->non_empty & BUCKET_BIT(last_bucket);
+    uint32_t       moved       = delay_queue->non_empty & ~BUCKET_BIT(last_bucket);
+
+    if (steps < last_bucket) {
+        uint32_t step = (uint32_t)steps;
+        for (uint32_t bucket = 0; bucket < last_bucket; bucket++) {
+            delay_queue->bucket_last[bucket] =
+                bucket + step < last_bucket ? delay_queue->bucket_last[bucket + step] : NULL;
+        }
+        delay_queue->non_empty = ((moved << step) & ~BUCKET_BIT(last_bucket)) | keep;
+    } else {
+        for (uint32_t bucket = 0; bucket < last_bucket; bucket++) {
+            delay_queue->bucket_last[bucket] = NULL;
+        }
+        delay_queue->non_empty = keep;
+    }
+
+    delay_queue->base += steps << delay_queue->shift;
+    splitLastBucket(delay_queue);
+}
+
+int32_t staticDelayQueueInit(staticDelayQueue_t* delay_queue,
+                             uint32_t            queue_size,
+                             uint32_t            node_size,
+                             staticDelayItem_t*  first_item,
+                             uint32_t            shift)
+{
+    if (delay_queue == NULL || first_item == NULL || shift >= 64) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    delay_queue->base      = 0;
+    delay_queue->shift     = shift;
+    delay_queue->non_empty = 0;
+    for (uint32_t bucket = 0; bucket < STATIC_DELAY_QUEUE_BUCKETS; bucket++) {
+        delay_queue->bucket_last[bucket] = NULL;
+    }
+
+    return staticQueueInit(&delay_queue->queue, queue_size, node_size, &first_item->node);
+}
+
+int32_t staticDelayQueuePut(staticDelayQueue_t* delay_queue,
+                            uint64_t            deadline,
+                            staticDelayItem_t** next_item)
+{
+    if (staticQueuefull(&delay_queue->queue)) {
+        return STATIC_QUEUE_FULL;
+    }
+
+    // The index is empty as well, move the buckets to start at this deadline
+    if (staticQueueEmpty(&delay_queue->queue)) {
+        delay_queue->base = deadline;
+    }
+
+    uint32_t           bucket   = bucketOf(delay_queue, deadline);
+    staticQueueItem_t* position = findPosition(delay_queue, deadline, bucket);
+    staticQueueItem_t* node;
+
+    int32_t result = staticQueuePutAfter(&delay_queue->queue, position, &node);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        return result;
+    }
+
+    // The new node is last in its bucket unless a later deadline in the same bucket follows it
+    staticQueueItem_t* bucket_last = delay_queue->bucket_last[bucket];
+    if (bucket_last == NULL || bucket_last == position) {
+        delay_queue->bucket_last[bucket] = node;
+        delay_queue->non_empty |= BUCKET_BIT(bucket);
+    }
+
+    *next_item             = CONTAINER_OF(node, staticDelayItem_t, node);
+    (*next_item)->deadline = deadline;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticDelayQueuePopIfDue(staticDelayQueue_t* delay_queue,
+                                 uint64_t            now,
+                                 staticDelayItem_t** pop_item)
+{
+    staticQueueItem_t* node;
+
+    int32_t result = staticQueuePeak(&delay_queue->queue, &node);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        return result;
+    }
+
+    if (deadlineOf(node) > now) {
+        return STATIC_QUEUE_EMPTY;
+    }
+
+    unindex(delay_queue, node);
+    staticQueuePop(&delay_queue->queue, &node);
+    *pop_item = CONTAINER_OF(node, staticDelayItem_t, node);
+    advanceBase(delay_queue);
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticDelayQueuePeak(staticDelayQueue_t* delay_queue, staticDelayItem_t** peak_item)
+{
+    staticQueueItem_t* node;
+
+    int32_t result = staticQueuePeak(&delay_queue->queue, &node);
+    if (result == STATIC_QUEUE_SUCCESS) {
+        *peak_item = CONTAINER_OF(node, staticDelayItem_t, node);
+    }
+
+    return result;
+}
+
+int32_t staticDelayQueueErase(staticDelayQueue_t* delay_queue, staticDelayItem_t* item)
+{
+    if (item == NULL || !item->node.active) {
+        return STATIC_QUEUE_NOT_IN_QUEUE;
+    }
+
+    unindex(delay_queue, &item->node);
+    int32_t result = staticQueueErase(&delay_queue->queue, &item->node);
+    advanceBase(delay_queue);
+
+    return result;
+}
+
+bool staticDelayQueueEmpty(staticDelayQueue_t* delay_queue)
+{
+    return staticQueueEmpty(&delay_queue->queue);
+}
@@ -0,0 +1,140 @@
+/**
+ * @file:       static_delay_queue.h
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Header file for static delay queue module
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#ifndef INC_STATIC_DELAY_QUEUE_H_
+#define INC_STATIC_DELAY_QUEUE_H_
+
+#include "static_queue.h"
+
+/**
+ * A static queue kept sorted by a 64 bit deadline, the item with the earliest deadline is always
+ * the next to pop. Items with equal deadlines keep their put order.
+ *
+ * To find the insert position the delay queue keeps a bucket index: the deadline range after the
+ * base deadline is split into STATIC_DELAY_QUEUE_BUCKETS buckets of 2^shift ticks each and the
+ * index holds the last item of each non-empty bucket. An insert looks up the closest non-empty
+ * bucket with one count leading zeros and only walks the items inside that bucket. The base is
+ * set to the first deadline put in an empty queue, deadlines past the last bucket share it.
+ * When bucket 0 runs empty the buckets rotate like a timing wheel, the base moves up to the
+ * bucket of the earliest deadline and the items in range are taken out of the last bucket.
+ *
+ * Embed a staticDelayItem_t named delay in the item struct
+ *     typedef struct {
+ *         uint32_t           my_data;
+ *         staticDelayItem_t  delay;
+ *     } myItem_t;
+ *     myItem_t          my_array[QUEUE_SIZE];
+ *     staticDelayQueue_t my_delay_queue;
+ *     STATIC_DELAY_QUEUE_INIT(&my_delay_queue, my_array, QUEUE_SIZE, 10);
+ *
+ * All puts, pops and erases must go through the delay queue to keep the index in sync.
+ */
+
+#define STATIC_DELAY_QUEUE_BUCKETS 32
+
+typedef struct {
+    uint64_t          deadline;
+    staticQueueItem_t node;
+} staticDelayItem_t;
+
+typedef struct {
+    staticQueue_t      queue;
+    uint64_t           base;                                   // Deadline at the start of bucket 0
+    uint32_t           shift;                                  // Bucket width is 2^shift
+    uint32_t           non_empty;                              // Bit (31 - bucket) is set if the bucket has items
+    staticQueueItem_t* bucket_last[STATIC_DELAY_QUEUE_BUCKETS]; // Last item in each bucket
+} staticDelayQueue_t;
+
+/**
+ * Initialize a delay queue
+ * Input: Delay queue instance
+ * Input: Number of items in the queue
+ * Input: Size of each item, including the staticDelayItem_t
+ * Input: Pointer to the staticDelayItem_t of the first item
+ * Input: Bucket width is 2^shift deadline ticks, pick it so the usual delays span a few buckets
+ * Returns: queueErr_t
+ */
+int32_t staticDelayQueueInit(staticDelayQueue_t* delay_queue,
+                             uint32_t            queue_size,
+                             uint32_t            node_size,
+                             staticDelayItem_t*  first_item,
+                             uint32_t            shift);
+
+/**
+ * Put an item in deadline order
+ * Input: Delay queue instance
+ * Input: Deadline of the item
+ * Input: This pointer wil be populated with the pointer to the relevant item to write data to
+ * Returns: queueErr_t
+ */
+int32_t staticDelayQueuePut(staticDelayQueue_t* delay_queue,
+                            uint64_t            deadline,
+                            staticDelayItem_t** next_item);
+
+/**
+ * Get and remove the item with the earliest deadline, if that deadline has passed
+ * Input: Delay queue instance
+ * Input: Current time, an item is due when deadline <= now
+ * Input: This pointer will be populated with the pop'ed item
+ * Returns: queueErr_t, STATIC_QUEUE_EMPTY if no item is due
+ */
+int32_t staticDelayQueuePopIfDue(staticDelayQueue_t* delay_queue,
+                                 uint64_t            now,
+                                 staticDelayItem_t** pop_item);
+
+/**
+ * Get the item with the earliest deadline, but do not remove it
+ * Input: Delay queue instance
+ * Input: This pointer will be populated with the item
+ * Returns: queueErr_t
+ */
+int32_t staticDelayQueuePeak(staticDelayQueue_t* delay_queue, staticDelayItem_t** peak_item);
+
+/**
+ * Erase a specific item from the delay queue
+ * Input: Delay queue instance
+ * Input: Pointer to the item to erase
+ * Returns: queueErr_t
+ */
+int32_t staticDelayQueueErase(staticDelayQueue_t* delay_queue, staticDelayItem_t* item);
+
+/**
+ * Check if the delay queue is empty
+ * Input: Delay queue instance
+ * Returns: true if empty
+ */
+bool staticDelayQueueEmpty(staticDelayQueue_t* delay_queue);
+
+/**
+ * This is a macro that makes it more safe to initialize a delay queue
+ */
+#define STATIC_DELAY_QUEUE_INIT(delay_queue, list, size, shift) \
+    staticDelayQueueInit((delay_queue), (size), sizeof((list)[0]), &list->delay, (shift))
+
+#endif /* INC_STATIC_DELAY_QUEUE_H_ */
@@ -0,0 +1,121 @@
+/**
+ * @file:       static_key_index.h
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Open addressed key index shared by the keyed containers
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#ifndef INC_STATIC_KEY_INDEX_H_
+#define INC_STATIC_KEY_INDEX_H_
+
+#include "static_queue.h"
+
+/**
+ * An open addressed hash index from a 64 bit key to a queued item, used by static_lru_cache and
+ * static_coalesce_queue. The slots are a caller owned array of pointers with a power of two size,
+ * lookups use linear probing and deletes shift later entries back so the index never fills up
+ * with tombstones.
+ */
+
+typedef struct {
+    uint64_t          key;
+    staticQueueItem_t node;
+} staticKeyItem_t;
+
+typedef struct {
+    staticKeyItem_t** slots;
+    uint32_t          mask;
+    uint32_t          shift; // 64 - log2(index size), the hash keeps the top bits
+} staticKeyIndex_t;
+
+// Set up an empty index, the size must be a power of two larger than the number of items
+static inline int32_t staticKeyIndexInit(staticKeyIndex_t* index, staticKeyItem_t** slots, uint32_t size, uint32_t num_items)
+{
+    if (slots == NULL || size <= num_items || (size & (size - 1)) != 0) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    uint32_t bits = 0;
+    while ((1u << bits) < size) {
+        bits++;
+    }
+
+    index->slots = slots;
+    index->mask  = size - 1;
+    index->shift = 64 - bits;
+
+    for (uint32_t slot = 0; slot < size; slot++) {
+        slots[slot] = NULL;
+    }
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+// Fibonacci hashing, the multiply mixes all key bits into the top bits
+static inline uint32_t staticKeyIndexHash(staticKeyIndex_t* index, uint64_t key)
+{
+    return (uint32_t)((key * 0x9E3779B97F4A7C15ull) >> index->shift);
+}
+
+// Returns the slot of the key, or the empty slot where it would be inserted
+static inline uint32_t staticKeyIndexFind(staticKeyIndex_t* index, uint64_t key)
+{
+    uint32_t slot = staticKeyIndexHash(index, key);
+    while (index->slots[slot] != NULL && index->slots[slot]->key != key) {
+        slot = (slot + 1) & index->mask;
+    }
+
+    return slot;
+}
+
+// Clear a slot and shift later entries of the probe run back, so lookups never stop too early
+static inline void staticKeyIndexDelete(staticKeyIndex_t* index, uint32_t slot)
+{
+    staticKeyItem_t** slots = index->slots;
+    uint32_t          next  = slot;
+
+    for (;;) {
+        slots[slot] = NULL;
+
+        for (;;) {
+            next = (next + 1) & index->mask;
+            if (slots[next] == NULL) {
+                return;
+            }
+
+            // Entries whose home is cyclically in (slot, next] must stay where they are
+            uint32_t home = staticKeyIndexHash(index, slots[next]->key);
+            bool     stay = (slot <= next) ? (slot < home && home <= next) : (slot < home || home <= next);
+            if (!stay) {
+                break;
+            }
+        }
+
+        slots[slot] = slots[next];
+        slot        = next;
+    }
+}
+
+#endif /* INC_STATIC_KEY_INDEX_H_ */
@@ -0,0 +1,145 @@
+/**
+ * @file:       static_lru_cache.c
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Implementation of static LRU cache module
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "static_lru_cache.h"
+
+static inline staticLruItem_t* entryOf(staticQueueItem_t* node)
+{
+    return CONTAINER_OF(node, staticLruItem_t, node);
+}
+
+int32_t staticLruCacheInit(staticLruCache_t* cache,
+                           uint32_t          cache_size,
+                           uint32_t          node_size,
+                           staticLruItem_t*  first_item,
+                           staticLruItem_t** index,
+                           uint32_t          index_size)
+{
+    if (cache == NULL || first_item == NULL ||
+        staticKeyIndexInit(&cache->index, index, index_size, cache_size) != STATIC_QUEUE_SUCCESS) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    cache->evict_cb  = NULL;
+    cache->evict_ctx = NULL;
+
+    return staticQueueInit(&cache->queue, cache_size, node_size, &first_item->node);
+}
+
+void staticLruCacheSetEvictCallback(staticLruCache_t* cache, staticLruEvictCb_t evict_cb, void* ctx)
+{
+    cache->evict_cb  = evict_cb;
+    cache->evict_ctx = ctx;
+}
+
+int32_t staticLruCacheGet(staticLruCache_t* cache, uint64_t key, staticLruItem_t** item)
+{
+    staticLruItem_t* entry = cache->index.slots[staticKeyIndexFind(&cache->index, key)];
+    if (entry == NULL) {
+        return STATIC_QUEUE_NOT_IN_QUEUE;
+    }
+
+    staticQueueMoveLast(&cache->queue, &entry->node);
+    *item = entry;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticLruCachePut(staticLruCache_t* cache, uint64_t key, staticLruItem_t** item)
+{
+    uint32_t slot = staticKeyIndexFind(&cache->index, key);
+    if (cache->index.slots[slot] != NULL) {
+        staticQueueMoveLast(&cache->queue, &cache->index.slots[slot]->node);
+        *item = cache->index.slots[slot];
+        return STATIC_QUEUE_SUCCESS;
+    }
+
+    if (staticQueuefull(&cache->queue)) {
+        staticLruCacheEvict(cache);
+
+        // The backward shift may have moved entries into the free slot, look it up again
+        slot = staticKeyIndexFind(&cache->index, key);
+    }
+
+    staticQueueItem_t* node;
+    int32_t            result = staticQueuePut(&cache->queue, &node);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        return result;
+    }
+
+    staticLruItem_t* entry = entryOf(node);
+    entry->key               = key;
+    cache->index.slots[slot] = entry;
+    *item                    = entry;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticLruCacheTouch(staticLruCache_t* cache, staticLruItem_t* item)
+{
+    return staticQueueMoveLast(&cache->queue, &item->node);
+}
+
+int32_t staticLruCacheEvict(staticLruCache_t* cache)
+{
+    staticQueueItem_t* node;
+
+    int32_t result = staticQueuePeak(&cache->queue, &node);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        return result;
+    }
+
+    staticLruItem_t* entry = entryOf(node);
+    if (cache->evict_cb != NULL) {
+        cache->evict_cb(cache, entry, cache->evict_ctx);
+    }
+
+    staticKeyIndexDelete(&cache->index, staticKeyIndexFind(&cache->index, entry->key));
+    return staticQueuePop(&cache->queue, &node);
+}
+
+int32_t staticLruCacheRemove(staticLruCache_t* cache, uint64_t key)
+{
+    uint32_t         slot  = staticKeyIndexFind(&cache->index, key);
+    staticLruItem_t* entry = cache->index.slots[slot];
+    if (entry == NULL) {
+        return STATIC_QUEUE_NOT_IN_QUEUE;
+    }
+
+    staticKeyIndexDelete(&cache->index, slot);
+
+    staticQueueItem_t* node;
+    staticQueueMoveLast(&cache->queue, &entry->node);
+    return staticQueuePopLast(&cache->queue, &node);
+}
+
+uint32_t staticLruCacheGetNumItems(staticLruCache_t* cache)
+{
+    return (uint32_t)staticQueueGetNumItems(&cache->queue);
+}
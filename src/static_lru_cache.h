@@ -0,0 +1,150 @@
+/**
+ * @file:       static_lru_cache.h
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Header file for static LRU cache module
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#ifndef INC_STATIC_LRU_CACHE_H_
+#define INC_STATIC_LRU_CACHE_H_
+
+#include "static_key_index.h"
+
+/**
+ * A fixed capacity LRU cache on static storage. The entries live in a static queue ordered from
+ * least to most recently used, and an open addressed hash index maps a 64 bit key to its entry.
+ * Get, put, touch and evict are all O(1), the index uses linear probing with backward shift
+ * deletion so it never fills up with tombstones.
+ *
+ * Embed a staticLruItem_t named entry in the item struct, the index is an array of pointers with a
+ * power of two size larger than the capacity, twice the capacity keeps the probes short
+ *     typedef struct {
+ *         uint32_t        my_data;
+ *         staticLruItem_t entry;
+ *     } myItem_t;
+ *     myItem_t          my_array[CACHE_SIZE];
+ *     staticLruItem_t*  my_index[2 * CACHE_SIZE];
+ *     staticLruCache_t  my_cache;
+ *     STATIC_LRU_CACHE_INIT(&my_cache, my_array, CACHE_SIZE, my_index);
+ */
+
+typedef staticKeyItem_t staticLruItem_t;
+
+typedef struct staticLruCache staticLruCache_t;
+
+/**
+ * Called with an entry that is about to be evicted, the entry is reused after the callback returns
+ */
+typedef void (*staticLruEvictCb_t)(staticLruCache_t* cache, staticLruItem_t* item, void* ctx);
+
+struct staticLruCache {
+    staticQueue_t      queue;
+    staticKeyIndex_t   index;
+    staticLruEvictCb_t evict_cb;
+    void*              evict_ctx;
+};
+
+/**
+ * Initialize an LRU cache
+ * Input: Cache instance
+ * Input: Number of entries
+ * Input: Size of each item, including the staticLruItem_t
+ * Input: Pointer to the staticLruItem_t of the first item
+ * Input: Index array, it is cleared here
+ * Input: Number of index slots, a power of two larger than the number of entries
+ * Returns: queueErr_t
+ */
+int32_t staticLruCacheInit(staticLruCache_t* cache,
+                           uint32_t          cache_size,
+                           uint32_t          node_size,
+                           staticLruItem_t*  first_item,
+                           staticLruItem_t** index,
+                           uint32_t          index_size);
+
+/**
+ * Set the callback that is called for every evicted entry
+ * Input: Cache instance
+ * Input: Callback, NULL to disable
+ * Input: User context passed to the callback
+ */
+void staticLruCacheSetEvictCallback(staticLruCache_t* cache, staticLruEvictCb_t evict_cb, void* ctx);
+
+/**
+ * Look up an entry and mark it as most recently used
+ * Input: Cache instance
+ * Input: Key to look up
+ * Input: This pointer will be populated with the entry
+ * Returns: queueErr_t, STATIC_QUEUE_NOT_IN_QUEUE on a miss
+ */
+int32_t staticLruCacheGet(staticLruCache_t* cache, uint64_t key, staticLruItem_t** item);
+
+/**
+ * Get the entry for a key as most recently used. An existing entry is returned as is, otherwise
+ * a free entry is used, or the least recently used entry is evicted if the cache is full.
+ * Input: Cache instance
+ * Input: Key to put
+ * Input: This pointer will be populated with the entry to write data to
+ * Returns: queueErr_t
+ */
+int32_t staticLruCachePut(staticLruCache_t* cache, uint64_t key, staticLruItem_t** item);
+
+/**
+ * Mark an entry as most recently used without a lookup
+ * Input: Cache instance
+ * Input: Entry, must be in this cache
+ * Returns: queueErr_t
+ */
+int32_t staticLruCacheTouch(staticLruCache_t* cache, staticLruItem_t* item);
+
+/**
+ * Evict the least recently used entry, the evict callback is called for it
+ * Input: Cache instance
+ * Returns: queueErr_t
+ */
+int32_t staticLruCacheEvict(staticLruCache_t* cache);
+
+/**
+ * Remove the entry for a key, the evict callback is not called
+ * Input: Cache instance
+ * Input: Key to remove
+ * Returns: queueErr_t, STATIC_QUEUE_NOT_IN_QUEUE if the key is not cached
+ */
+int32_t staticLruCacheRemove(staticLruCache_t* cache, uint64_t key);
+
+/**
+ * Get the number of entries in the cache
+ * Input: Cache instance
+ * Returns: Number of entries
+ */
+uint32_t staticLruCacheGetNumItems(staticLruCache_t* cache);
+
+/**
+ * This is a macro that makes it more safe to initialize an LRU cache
+ */
+#define STATIC_LRU_CACHE_INIT(cache, list, size, index_array) \
+    staticLruCacheInit((cache), (size), sizeof((list)[0]), &list->entry, (index_array), \
+                       sizeof(index_array) / sizeof((index_array)[0]))
+
+#endif /* INC_STATIC_LRU_CACHE_H_ */
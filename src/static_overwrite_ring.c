@@ -0,0 +1,126 @@
+/**
+ * @file:       static_overwrite_ring.c
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Implementation of lossy overwrite ring with concurrent snapshots
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include <string.h>
+#include "static_overwrite_ring.h"
+
+#define STAMP_WRITING(seq) (((seq) << 1) | 1u)
+#define STAMP_DONE(seq)    (((seq) + 1u) << 1)
+
+int32_t staticOverwriteRingInit(staticOverwriteRing_t* ring,
+                                void*                  slots,
+                                uint32_t*              stamps,
+                                uint32_t               num_slots,
+                                uint32_t               slot_size)
+{
+    if (ring == NULL || slots == NULL || stamps == NULL || num_slots == 0 ||
+        (num_slots & (num_slots - 1)) != 0) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    ring->slots     = (uint8_t*)slots;
+    ring->stamps    = stamps;
+    ring->slot_size = slot_size;
+    ring->num_slots = num_slots;
+    ring->mask      = num_slots - 1;
+    ring->write_seq = 0;
+
+    // Stamp 0 never matches a finished sample
+    memset(stamps, 0, sizeof(stamps[0]) * num_slots);
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticOverwriteRingReserve(staticOverwriteRing_t* ring, void** slot)
+{
+    uint32_t seq   = ring->write_seq;
+    uint32_t index = seq & ring->mask;
+
+    // Mark the slot as being written before any of its data changes
+    __atomic_store_n(&ring->stamps[index], STAMP_WRITING(seq), __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    *slot = ring->slots + (size_t)index * ring->slot_size;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticOverwriteRingCommit(staticOverwriteRing_t* ring)
+{
+    uint32_t seq   = ring->write_seq;
+    uint32_t index = seq & ring->mask;
+
+    __atomic_store_n(&ring->stamps[index], STAMP_DONE(seq), __ATOMIC_RELEASE);
+    __atomic_store_n(&ring->write_seq, seq + 1, __ATOMIC_RELEASE);
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticOverwriteRingSnapshot(staticOverwriteRing_t* ring,
+                                    void*                  dst,
+                                    uint32_t               max_items,
+                                    uint32_t*              first_seq)
+{
+    uint32_t end   = __atomic_load_n(&ring->write_seq, __ATOMIC_ACQUIRE);
+    uint32_t count = end < ring->num_slots ? end : ring->num_slots;
+    if (count > max_items) {
+        count = max_items;
+    }
+
+    uint8_t* out    = (uint8_t*)dst;
+    uint32_t start  = end - count;
+    int32_t  copied = 0;
+
+    for (uint32_t seq = start; seq != end; seq++) {
+        uint32_t index  = seq & ring->mask;
+        uint8_t* slot   = ring->slots + (size_t)index * ring->slot_size;
+        uint32_t before = __atomic_load_n(&ring->stamps[index], __ATOMIC_ACQUIRE);
+
+        if (before == STAMP_DONE(seq)) {
+            memcpy(out + (size_t)copied * ring->slot_size, slot, ring->slot_size);
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        }
+
+        uint32_t after = __atomic_load_n(&ring->stamps[index], __ATOMIC_RELAXED);
+        if (before != STAMP_DONE(seq) || after != before) {
+            // The writer has lapped this sample, keep only the newer samples after it
+            copied = 0;
+            start  = seq + 1;
+            continue;
+        }
+
+        copied++;
+    }
+
+    if (first_seq != NULL) {
+        *first_seq = start;
+    }
+
+    return copied;
+}
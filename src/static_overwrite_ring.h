@@ -0,0 +1,122 @@
+/**
+ * @file:       static_overwrite_ring.h
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Header file for lossy overwrite ring with concurrent snapshots
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#ifndef INC_STATIC_OVERWRITE_RING_H_
+#define INC_STATIC_OVERWRITE_RING_H_
+
+#include "static_queue.h"
+
+/**
+ * Lossy ring for telemetry and debug capture, it always keeps the newest samples. The writer
+ * never blocks and never fails, it overwrites the oldest slot. A reader on another thread can
+ * copy out a snapshot of the newest samples at any time without stopping the writer.
+ *
+ * Every slot has a stamp, written odd while the writer fills the slot and even with the sample
+ * sequence number once it is done. The reader validates the stamp before and after copying a
+ * slot, samples that were overwritten during the copy are left out of the snapshot.
+ *
+ *     static mySample_t my_samples[64];
+ *     static uint32_t   my_stamps[64];
+ *     staticOverwriteRing_t my_ring;
+ *     STATIC_OVERWRITE_RING_INIT(&my_ring, my_samples, my_stamps);
+ *
+ * Writer:
+ *     void* slot;
+ *     staticOverwriteRingReserve(&my_ring, &slot);
+ *     ((mySample_t*)slot)->value = 1337;
+ *     staticOverwriteRingCommit(&my_ring);
+ *
+ * Reader:
+ *     mySample_t snapshot[64];
+ *     uint32_t   first_seq;
+ *     int32_t    num = staticOverwriteRingSnapshot(&my_ring, snapshot, 64, &first_seq);
+ *
+ * There must only be one writer.
+ */
+
+typedef struct {
+    uint8_t*  slots;
+    uint32_t* stamps;
+    uint32_t  slot_size;
+    uint32_t  num_slots;
+    uint32_t  mask;
+    uint32_t  write_seq; // Sequence number of the next sample
+} staticOverwriteRing_t;
+
+/**
+ * Initialize an overwrite ring
+ * Input: Ring instance
+ * Input: Pointer to the first slot
+ * Input: Pointer to an array of num_slots stamps
+ * Input: Number of slots, must be a power of two
+ * Input: The sizeof a slot
+ * Returns: queueErr_t
+ */
+int32_t staticOverwriteRingInit(staticOverwriteRing_t* ring,
+                                void*                  slots,
+                                uint32_t*              stamps,
+                                uint32_t               num_slots,
+                                uint32_t               slot_size);
+
+/**
+ * Get the slot for the next sample, overwriting the oldest sample if the ring is full
+ * Input: Ring instance
+ * Input: This pointer will be populated with the slot to write data to
+ * Returns: queueErr_t
+ */
+int32_t staticOverwriteRingReserve(staticOverwriteRing_t* ring, void** slot);
+
+/**
+ * Publish the reserved sample
+ * Input: Ring instance
+ * Returns: queueErr_t
+ */
+int32_t staticOverwriteRingCommit(staticOverwriteRing_t* ring);
+
+/**
+ * Copy the newest samples, oldest first, to a buffer. Safe to call while the writer is running.
+ * Input: Ring instance
+ * Input: Destination buffer, room for max_items slots
+ * Input: Max number of samples to copy
+ * Input: This pointer will be populated with the sequence number of the first copied sample,
+ *        may be NULL
+ * Returns: Number of samples copied
+ */
+int32_t staticOverwriteRingSnapshot(staticOverwriteRing_t* ring,
+                                    void*                  dst,
+                                    uint32_t               max_items,
+                                    uint32_t*              first_seq);
+
+/**
+ * This is a macro that makes it more safe to initialize a ring from arrays
+ */
+#define STATIC_OVERWRITE_RING_INIT(ring, array, stamps) \
+    staticOverwriteRingInit((ring), (array), (stamps), sizeof(array) / sizeof((array)[0]), sizeof((array)[0]))
+
+#endif /* INC_STATIC_OVERWRITE_RING_H_ */
@@ -0,0 +1,282 @@
+/**
+ * @file:       static_pipeline.c
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Implementation of static queue pipeline module
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#define _GNU_SOURCE
+#include "static_pipeline.h"
+#include <sched.h>
+#include <time.h>
+
+static inline uint64_t nowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static inline uint32_t linkDepth(staticPipelineLink_t* link)
+{
+    return __atomic_load_n(&link->head, __ATOMIC_ACQUIRE) - __atomic_load_n(&link->tail, __ATOMIC_ACQUIRE);
+}
+
+// Every link can hold all items in circulation, so the producer never has to wait for space
+static inline void linkPush(staticPipelineLink_t* link, staticQueueItem_t** items, uint32_t num)
+{
+    uint32_t head = link->head;
+    for (uint32_t i = 0; i < num; i++) {
+        link->slots[(head + i) & link->mask] = items[i];
+    }
+
+    __atomic_store_n(&link->head, head + num, __ATOMIC_RELEASE);
+}
+
+static inline uint32_t linkPop(staticPipelineLink_t* link, staticQueueItem_t** items, uint32_t max)
+{
+    uint32_t tail = link->tail;
+    uint32_t num  = __atomic_load_n(&link->head, __ATOMIC_ACQUIRE) - tail;
+    if (num > max) {
+        num = max;
+    }
+
+    for (uint32_t i = 0; i < num; i++) {
+        items[i] = link->slots[(tail + i) & link->mask];
+    }
+
+    __atomic_store_n(&link->tail, tail + num, __ATOMIC_RELEASE);
+    return num;
+}
+
+static void pinThread(staticPipelineStage_t* stage)
+{
+#if defined(__linux__)
+    if (stage->cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(stage->cpu, &cpus);
+        stage->pinned = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+    }
+#endif
+}
+
+static void* stageThread(void* arg)
+{
+    staticPipelineStage_t* stage    = arg;
+    staticPipeline_t*      pipeline = stage->pipeline;
+    staticPipelineStage_t* upstream = stage == pipeline->stages ? NULL : stage - 1;
+    staticQueueItem_t*     in_items[STATIC_PIPELINE_MAX_BATCH];
+    staticQueueItem_t*     out_items[STATIC_PIPELINE_MAX_BATCH];
+    bool                   stopping = false;
+
+    pinThread(stage);
+
+    while (!stopping) {
+        if (upstream == NULL && __atomic_load_n(&pipeline->stop, __ATOMIC_ACQUIRE)) {
+            break;
+        }
+
+        uint32_t num = linkPop(stage->in, in_items, pipeline->batch);
+        if (num == 0) {
+            // The upstream stage publishes its last items before done, so check it first
+            if (upstream != NULL && __atomic_load_n(&upstream->done, __ATOMIC_ACQUIRE) &&
+                linkDepth(stage->in) == 0) {
+                break;
+            }
+            __atomic_store_n(&stage->stalls, stage->stalls + 1, __ATOMIC_RELAXED);
+            sched_yield();
+            continue;
+        }
+
+        uint64_t start   = nowNs();
+        uint32_t num_out = 0;
+        for (uint32_t i = 0; i < num; i++) {
+            int32_t result = stage->fn(stage, in_items[i], stage->ctx);
+            if (upstream == NULL && result == STATIC_QUEUE_CB_STOP) {
+                stopping = true;
+                break;
+            }
+            out_items[num_out++] = in_items[i];
+        }
+
+        linkPush(stage->out, out_items, num_out);
+        __atomic_store_n(&stage->busy_ns, stage->busy_ns + (nowNs() - start), __ATOMIC_RELAXED);
+        __atomic_store_n(&stage->items, stage->items + num_out, __ATOMIC_RELAXED);
+    }
+
+    __atomic_store_n(&stage->done, true, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+int32_t staticPipelineInit(staticPipeline_t*      pipeline,
+                           staticPipelineStage_t* stages,
+                           staticPipelineLink_t*  links,
+                           uint32_t               num_stages,
+                           staticQueueItem_t**    link_slots,
+                           uint32_t               link_size,
+                           uint32_t               batch)
+{
+    if (pipeline == NULL || stages == NULL || links == NULL || link_slots == NULL || num_stages < 2 ||
+        link_size == 0 || (link_size & (link_size - 1)) != 0 || batch == 0 ||
+        batch > STATIC_PIPELINE_MAX_BATCH) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    pipeline->stages     = stages;
+    pipeline->links      = links;
+    pipeline->num_stages = num_stages;
+    pipeline->link_size  = link_size;
+    pipeline->batch      = batch;
+    pipeline->num_items  = 0;
+    pipeline->start_ns   = 0;
+    pipeline->stop       = false;
+
+    for (uint32_t i = 0; i < num_stages; i++) {
+        links[i].slots = &link_slots[i * link_size];
+        links[i].mask  = link_size - 1;
+        links[i].head  = 0;
+        links[i].tail  = 0;
+
+        stages[i].name     = NULL;
+        stages[i].fn       = NULL;
+        stages[i].ctx      = NULL;
+        stages[i].cpu      = -1;
+        stages[i].in       = &links[i];
+        stages[i].out      = &links[(i + 1) % num_stages];
+        stages[i].pipeline = pipeline;
+        stages[i].pinned   = false;
+        stages[i].done     = false;
+        stages[i].started  = false;
+        stages[i].items    = 0;
+        stages[i].stalls   = 0;
+        stages[i].busy_ns  = 0;
+    }
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticPipelineSetStage(staticPipeline_t*       pipeline,
+                               uint32_t                index,
+                               const char*             name,
+                               staticPipelineStageFn_t fn,
+                               void*                   ctx,
+                               int32_t                 cpu)
+{
+    if (index >= pipeline->num_stages || fn == NULL) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    pipeline->stages[index].name = name;
+    pipeline->stages[index].fn   = fn;
+    pipeline->stages[index].ctx  = ctx;
+    pipeline->stages[index].cpu  = cpu;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticPipelineSeed(staticPipeline_t* pipeline, staticQueue_t* pool)
+{
+    if (pool == NULL) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    if (pipeline->num_items + pool->queue_length > pipeline->link_size) {
+        return STATIC_QUEUE_FULL;
+    }
+
+    staticQueueItem_t* item = pool->first_item;
+    for (uint32_t i = 0; i < pool->queue_length; i++) {
+        linkPush(&pipeline->links[0], &item, 1);
+        item = (staticQueueItem_t*)((uint8_t*)item + pool->node_size);
+    }
+    pipeline->num_items += pool->queue_length;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticPipelineStart(staticPipeline_t* pipeline)
+{
+    for (uint32_t i = 0; i < pipeline->num_stages; i++) {
+        if (pipeline->stages[i].fn == NULL) {
+            return STATIC_QUEUE_INVALID;
+        }
+    }
+
+    pipeline->start_ns = nowNs();
+
+    // Start from the sink so every stage has its consumer running before items arrive
+    for (uint32_t i = pipeline->num_stages; i > 0; i--) {
+        staticPipelineStage_t* stage = &pipeline->stages[i - 1];
+        if (pthread_create(&stage->thread, NULL, stageThread, stage) != 0) {
+            // Mark the stages that never ran as done, so the ones already running drain and exit
+            for (uint32_t j = 0; j < i; j++) {
+                __atomic_store_n(&pipeline->stages[j].done, true, __ATOMIC_RELEASE);
+            }
+            staticPipelineJoin(pipeline);
+            return STATIC_QUEUE_IO_ERROR;
+        }
+        stage->started = true;
+    }
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+void staticPipelineStop(staticPipeline_t* pipeline)
+{
+    __atomic_store_n(&pipeline->stop, true, __ATOMIC_RELEASE);
+}
+
+int32_t staticPipelineJoin(staticPipeline_t* pipeline)
+{
+    for (uint32_t i = 0; i < pipeline->num_stages; i++) {
+        staticPipelineStage_t* stage = &pipeline->stages[i];
+        if (stage->started) {
+            pthread_join(stage->thread, NULL);
+            stage->started = false;
+        }
+    }
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticPipelineGetStats(staticPipeline_t* pipeline, uint32_t index, staticPipelineStats_t* stats)
+{
+    if (index >= pipeline->num_stages || stats == NULL) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    staticPipelineStage_t* stage   = &pipeline->stages[index];
+    uint64_t               elapsed = nowNs() - pipeline->start_ns;
+
+    stats->name          = stage->name;
+    stats->items         = __atomic_load_n(&stage->items, __ATOMIC_RELAXED);
+    stats->stalls        = __atomic_load_n(&stage->stalls, __ATOMIC_RELAXED);
+    stats->busy_ns       = __atomic_load_n(&stage->busy_ns, __ATOMIC_RELAXED);
+    stats->items_per_sec = elapsed > 0 ? stats->items * 1e9 / elapsed : 0.0;
+    stats->depth         = linkDepth(stage->in);
+    stats->pinned        = stage->pinned;
+
+    return STATIC_QUEUE_SUCCESS;
+}
@@ -0,0 +1,205 @@
+/**
+ * @file:       static_pipeline.h
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Header file for static queue pipeline module
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#ifndef INC_STATIC_PIPELINE_H_
+#define INC_STATIC_PIPELINE_H_
+
+#include "static_queue.h"
+#include <pthread.h>
+
+/**
+ * A chain of processing stages, each running on its own thread, for example parse -> enrich ->
+ * serialize. Items are never copied, a stage hands the item node itself to the next stage.
+ *
+ * The stages are connected in a ring by single producer, single consumer links of item pointers:
+ * link i feeds stage i, and the last stage feeds link 0 which returns the items to the first
+ * stage. So the first stage is the source, it is handed free items to fill, and every item keeps
+ * circulating without an allocator. Each link moves up to batch items per atomic update.
+ *
+ * The links are not staticQueue_t. Every staticQueue_t operation writes the shared ring state,
+ * head, tail, the active and pending flags of the nodes and num_items, on both the put and the pop
+ * side, so a producer and a consumer on different threads would need a lock around every call.
+ * A link is a plain array of pointers where the producer owns head and the consumer owns tail,
+ * each index is written by one thread only and published with a release store. The queue given
+ * to staticPipelineSeed only provides the item array, its ring is not touched while items are in
+ * flight.
+ *
+ *     staticPipelineStage_t stages[3];
+ *     staticPipelineLink_t  links[3];
+ *     staticQueueItem_t*    link_slots[3 * 256];
+ *     staticPipeline_t      pipeline;
+ *
+ *     staticPipelineInit(&pipeline, stages, links, 3, link_slots, 256, 32);
+ *     staticPipelineSetStage(&pipeline, 0, "parse", parseFn, NULL, -1);
+ *     staticPipelineSetStage(&pipeline, 1, "enrich", enrichFn, NULL, 2);
+ *     staticPipelineSetStage(&pipeline, 2, "serialize", serializeFn, NULL, 3);
+ *     staticPipelineSeed(&pipeline, &my_item_queue);
+ *     staticPipelineStart(&pipeline);
+ *     ...
+ *     staticPipelineJoin(&pipeline);
+ *
+ * The source stage function returns STATIC_QUEUE_CB_STOP when it has no more input, the item it
+ * was given is then dropped and the later stages finish the items already in flight and exit.
+ * The return value of the other stage functions is not used, every item is passed on.
+ */
+
+#define STATIC_PIPELINE_MAX_BATCH 64
+
+typedef struct staticPipelineStage staticPipelineStage_t;
+typedef struct staticPipeline      staticPipeline_t;
+
+/**
+ * Process one item, called on the thread of the stage
+ */
+typedef int32_t (*staticPipelineStageFn_t)(staticPipelineStage_t* stage, staticQueueItem_t* item, void* ctx);
+
+typedef struct {
+    staticQueueItem_t** slots;
+    uint32_t            mask;
+    uint32_t            head; // Next slot to write, written by the producing stage
+    uint32_t            tail; // Next slot to read, written by the consuming stage
+} staticPipelineLink_t;
+
+struct staticPipelineStage {
+    const char*             name;
+    staticPipelineStageFn_t fn;
+    void*                   ctx;
+    int32_t                 cpu; // CPU to pin the thread to, -1 to not pin
+    staticPipelineLink_t*   in;
+    staticPipelineLink_t*   out;
+    staticPipeline_t*       pipeline;
+    pthread_t               thread;
+    bool                    pinned;
+    bool                    done;
+    bool                    started; // The thread runs and has not been joined
+
+    // Written by the stage thread, read with staticPipelineGetStats
+    uint64_t items;
+    uint64_t stalls;  // Times the stage found its input empty
+    uint64_t busy_ns; // Time spent in the stage function
+};
+
+struct staticPipeline {
+    staticPipelineStage_t* stages;
+    staticPipelineLink_t*  links;
+    uint32_t               num_stages;
+    uint32_t               link_size;
+    uint32_t               batch;
+    uint32_t               num_items;
+    uint64_t               start_ns;
+    bool                   stop;
+};
+
+typedef struct {
+    const char* name;
+    uint64_t    items;
+    uint64_t    stalls;
+    uint64_t    busy_ns;
+    double      items_per_sec; // Since staticPipelineStart
+    uint32_t    depth;         // Items waiting in front of the stage
+    bool        pinned;
+} staticPipelineStats_t;
+
+/**
+ * Initialize a pipeline
+ * Input: Pipeline instance
+ * Input: Array of stages
+ * Input: Array of links, one per stage
+ * Input: Number of stages, at least 2
+ * Input: Slots for the links, num_stages * link_size pointers
+ * Input: Slots per link, a power of two that can hold every item
+ * Input: Max items moved per link update, up to STATIC_PIPELINE_MAX_BATCH
+ * Returns: queueErr_t
+ */
+int32_t staticPipelineInit(staticPipeline_t*      pipeline,
+                           staticPipelineStage_t* stages,
+                           staticPipelineLink_t*  links,
+                           uint32_t               num_stages,
+                           staticQueueItem_t**    link_slots,
+                           uint32_t               link_size,
+                           uint32_t               batch);
+
+/**
+ * Set up a stage, stage 0 is the source
+ * Input: Pipeline instance
+ * Input: Stage index
+ * Input: Name used in the stats
+ * Input: Stage function
+ * Input: User context passed to the stage function
+ * Input: CPU to pin the stage thread to, -1 to not pin
+ * Returns: queueErr_t
+ */
+int32_t staticPipelineSetStage(staticPipeline_t*       pipeline,
+                               uint32_t                index,
+                               const char*             name,
+                               staticPipelineStageFn_t fn,
+                               void*                   ctx,
+                               int32_t                 cpu);
+
+/**
+ * Hand every item of a static queue to the source stage, the queue is only used for its item
+ * array and must not be used while the pipeline runs
+ * Input: Pipeline instance
+ * Input: Initialized queue, its items do not have to be put
+ * Returns: queueErr_t, STATIC_QUEUE_FULL if the links can not hold all items
+ */
+int32_t staticPipelineSeed(staticPipeline_t* pipeline, staticQueue_t* pool);
+
+/**
+ * Start one thread per stage
+ * Input: Pipeline instance
+ * Returns: queueErr_t, STATIC_QUEUE_IO_ERROR if a thread could not be created. The stages that
+ *          did start have then drained their items and been joined, the caller does not have to
+ *          call staticPipelineJoin, it returns at once if it does.
+ */
+int32_t staticPipelineStart(staticPipeline_t* pipeline);
+
+/**
+ * Ask the source stage to stop, the items in flight are still processed
+ * Input: Pipeline instance
+ */
+void staticPipelineStop(staticPipeline_t* pipeline);
+
+/**
+ * Wait for all stage threads to exit, stages that never started or were joined already are skipped
+ * Input: Pipeline instance
+ * Returns: queueErr_t
+ */
+int32_t staticPipelineJoin(staticPipeline_t* pipeline);
+
+/**
+ * Get the throughput and queue depth of a stage, may be called while the pipeline runs
+ * Input: Pipeline instance
+ * Input: Stage index
+ * Input: This will be populated with the stats
+ * Returns: queueErr_t
+ */
+int32_t staticPipelineGetStats(staticPipeline_t* pipeline, uint32_t index, staticPipelineStats_t* stats);
+
+#endif /* INC_STATIC_PIPELINE_H_ */
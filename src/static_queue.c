@@ -28,6 +28,50 @@
 
 #include "static_queue.h"
 
+// In inline mode static_queue.h already includes the hot paths as static inline functions
+#ifndef STATIC_QUEUE_INLINE
+#include "static_queue_inline.h"
+#endif
+
+#include <string.h>
+
+static inline uint8_t* payloadOf(staticQueue_t* queue, staticQueueItem_t* item)
+{
+    return (uint8_t*)item - queue->payload_offset;
+}
+
+static inline staticQueueItem_t* slotAt(staticQueue_t* queue, uint32_t index)
+{
+    return (staticQueueItem_t*)((uint8_t*)queue->first_item + (size_t)index * queue->node_size);
+}
+
+static inline uint32_t slotIndex(staticQueue_t* queue, staticQueueItem_t* item)
+{
+    return (uint32_t)(((uint8_t*)item - (uint8_t*)queue->first_item) / queue->node_size);
+}
+
+// Constant size copies for the common message sizes compile to a few plain loads and stores
+static inline void copyPayload(void* dst, const void* src, uint32_t size)
+{
+    switch (size) {
+        case 8:
+            memcpy(dst, src, 8);
+            break;
+        case 16:
+            memcpy(dst, src, 16);
+            break;
+        case 32:
+            memcpy(dst, src, 32);
+            break;
+        case 64:
+            memcpy(dst, src, 64);
+            break;
+        default:
+            memcpy(dst, src, size);
+            break;
+    }
+}
+
 int32_t staticQueueInit(staticQueue_t*     queue,
                         uint32_t           queue_size,
                         uint32_t           node_size,
@@ -37,6 +81,31 @@ int32_t staticQueueInit(staticQueue_t*     queue,
     queue->tail         = first_item;
     queue->first_item   = first_item;
     queue->queue_length = queue_size;
+    queue->node_size    = node_size;
+    queue->num_items    = 0;
+    queue->in_order     = true;
+
+    queue->high_watermark    = 0;
+    queue->low_watermark     = 0;
+    queue->above_watermark   = false;
+    queue->watermark_crossed = false;
+    queue->watermark_cb      = NULL;
+    queue->watermark_ctx     = NULL;
+
+    queue->payload_offset = 0;
+    queue->payload_size   = 0;
+
+    queue->stamp_offset = 0;
+    queue->clock        = NULL;
+    queue->clock_ctx    = NULL;
+
+#if STATIC_QUEUE_TRACE
+    queue->trace = NULL;
+#endif
+
+#if STATIC_QUEUE_SEQLOCK
+    queue->version = 0;
+#endif
 
     staticQueueItem_t* item = first_item;
     for (uint32_t i = 0; i < queue_size - 1; i++) {
@@ -51,119 +120,511 @@ int32_t staticQueueInit(staticQueue_t*     queue,
     return STATIC_QUEUE_SUCCESS;
 }
 
-bool staticQueuefull(staticQueue_t* queue)
+int32_t staticQueuePutFirst(staticQueue_t* queue, staticQueueItem_t** next_item)
 {
-    return (queue->head == queue->tail) && queue->head->active;
+    if (staticQueuefull(queue)) {
+        return STATIC_QUEUE_FULL;
+    }
+
+    // Move the tail one step back
+    staticQueueWriteBegin(queue);
+    STATIC_QUEUE_STORE(queue->tail, queue->tail->last);
+    *next_item           = queue->tail;
+    STATIC_QUEUE_STORE(queue->tail->active, true);
+    STATIC_QUEUE_STORE(queue->tail->pending, false);
+    staticQueueStamp(queue, queue->tail);
+    staticQueueCountUp(queue, 1);
+    staticQueueWriteEnd(queue);
+    STATIC_QUEUE_TRACE_OP(queue, STATIC_QUEUE_TRACE_PUT_FIRST, *next_item);
+
+    return STATIC_QUEUE_SUCCESS;
 }
 
-bool staticQueueEmpty(staticQueue_t* queue)
+int32_t staticQueuePutAfter(staticQueue_t*      queue,
+                            staticQueueItem_t*  position,
+                            staticQueueItem_t** next_item)
 {
-    return (queue->head == queue->tail) && !queue->head->active;
+    if (position == NULL) {
+        return staticQueuePutFirst(queue, next_item);
+    }
+
+    if (!position->active) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    if (position == queue->head->last) {
+        return staticQueuePut(queue, next_item);
+    }
+
+    if (staticQueuefull(queue)) {
+        return STATIC_QUEUE_FULL;
+    }
+
+    // Take the first free item, after head, out of the ring
+    staticQueueWriteBegin(queue);
+    queue->in_order = false;
+    staticQueueItem_t* item      = queue->head;
+    staticQueueItem_t* next_free = item->next;
+    bool               last_free = next_free == queue->tail;
+
+    item->last->next = item->next;
+    item->next->last = item->last;
+
+    // Insert: position <-> item <-> position->next
+    item->next           = position->next;
+    item->last           = position;
+    position->next->last = item;
+    position->next       = item;
+
+    // If that was the last free item the queue is now full, which is head == tail
+    STATIC_QUEUE_STORE(queue->head, last_free ? queue->tail : next_free);
+    STATIC_QUEUE_STORE(item->active, true);
+    STATIC_QUEUE_STORE(item->pending, false);
+    *next_item    = item;
+    staticQueueStamp(queue, item);
+    staticQueueCountUp(queue, 1);
+    staticQueueWriteEnd(queue);
+    STATIC_QUEUE_TRACE_OP(queue, STATIC_QUEUE_TRACE_PUT_AFTER, position);
+
+    return STATIC_QUEUE_SUCCESS;
 }
 
-int32_t staticQueuePutFirst(staticQueue_t* queue, staticQueueItem_t** next_item)
+int32_t staticQueuePutOverwrite(staticQueue_t*      queue,
+                                staticQueueItem_t** next_item,
+                                staticQueueItem_t** evicted_item)
 {
-    if (staticQueuefull(queue)) {
+    if (!staticQueuefull(queue)) {
+        if (evicted_item != NULL) {
+            *evicted_item = NULL;
+        }
+        return staticQueuePut(queue, next_item);
+    }
+
+    if (queue->tail->pending) {
         return STATIC_QUEUE_FULL;
     }
 
-    // Move the tail one step back
-    queue->tail         = queue->tail->last;
-    *next_item          = queue->tail;
-    queue->tail->active = true;
+    // Full means head == tail, reuse the oldest slot and move both ends one step
+    staticQueueWriteBegin(queue);
+    *next_item = queue->head;
+    if (evicted_item != NULL) {
+        *evicted_item = queue->head;
+    }
+    staticQueueStamp(queue, queue->head);
+    STATIC_QUEUE_STORE(queue->head, queue->head->next);
+    STATIC_QUEUE_STORE(queue->tail, queue->head);
+    staticQueueWriteEnd(queue);
+    STATIC_QUEUE_TRACE_OP(queue, STATIC_QUEUE_TRACE_UNSUPPORTED, NULL);
 
     return STATIC_QUEUE_SUCCESS;
 }
 
-int32_t staticQueuePut(staticQueue_t* queue, staticQueueItem_t** next_item)
+int32_t staticQueueReserve(staticQueue_t* queue, staticQueueItem_t** next_item)
 {
     if (staticQueuefull(queue)) {
         return STATIC_QUEUE_FULL;
     }
 
-    *next_item          = queue->head;
-    queue->head->active = true;
-    queue->head         = queue->head->next;
+    // The item takes its place in the queue, but stays hidden until committed
+    staticQueueWriteBegin(queue);
+    *next_item           = queue->head;
+    STATIC_QUEUE_STORE(queue->head->active, true);
+    STATIC_QUEUE_STORE(queue->head->pending, true);
+    staticQueueStamp(queue, queue->head);
+    STATIC_QUEUE_STORE(queue->head, queue->head->next);
+    staticQueueCountUp(queue, 1);
+    staticQueueWriteEnd(queue);
+    STATIC_QUEUE_TRACE_OP(queue, STATIC_QUEUE_TRACE_UNSUPPORTED, NULL);
 
     return STATIC_QUEUE_SUCCESS;
 }
 
-int32_t staticQueuePop(staticQueue_t* queue, staticQueueItem_t** pop_item)
+int32_t staticQueueReserveMany(staticQueue_t* queue, staticQueueItem_t** items, uint32_t num_items)
 {
-    if (staticQueueEmpty(queue)) {
+    if (queue == NULL || items == NULL) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    uint32_t reserved = 0;
+    staticQueueWriteBegin(queue);
+    while (reserved < num_items && !staticQueuefull(queue)) {
+        items[reserved]      = queue->head;
+        STATIC_QUEUE_STORE(queue->head->active, true);
+        STATIC_QUEUE_STORE(queue->head->pending, true);
+        staticQueueStamp(queue, queue->head);
+        STATIC_QUEUE_STORE(queue->head, queue->head->next);
+        reserved++;
+    }
+
+    staticQueueCountUp(queue, reserved);
+    staticQueueWriteEnd(queue);
+
+    if (reserved == 0 && num_items > 0) {
+        return STATIC_QUEUE_FULL;
+    }
+
+    STATIC_QUEUE_TRACE_OP(queue, STATIC_QUEUE_TRACE_UNSUPPORTED, NULL);
+
+    return reserved;
+}
+
+int32_t staticQueueCommit(staticQueue_t* queue, staticQueueItem_t* item)
+{
+    (void)queue;
+
+    if (!item->active || !item->pending) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    // Release store, so the payload is visible before the item is
+    __atomic_store_n(&item->pending, false, __ATOMIC_RELEASE);
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticQueueSetPayload(staticQueue_t* queue, uint32_t payload_offset, uint32_t payload_size)
+{
+    if (queue == NULL || payload_size == 0 || payload_size > payload_offset) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    queue->payload_offset = payload_offset;
+    queue->payload_size   = payload_size;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticQueuePush(staticQueue_t* queue, const void* src)
+{
+    int32_t result = staticQueuePushMany(queue, src, 1);
+    return result < 0 ? result : STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticQueueTake(staticQueue_t* queue, void* dst)
+{
+    int32_t result = staticQueueTakeMany(queue, dst, 1);
+    return result < 0 ? result : STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticQueuePushMany(staticQueue_t* queue, const void* src, uint32_t num_items)
+{
+    if (queue == NULL || src == NULL || queue->payload_size == 0) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    const uint8_t* payload = src;
+    uint32_t       size    = queue->payload_size;
+    uint32_t       pushed  = 0;
+
+    // Copy first and then put the item, there is no window where it is queued but half written
+    staticQueueWriteBegin(queue);
+    while (pushed < num_items && !staticQueuefull(queue)) {
+        staticQueueItem_t* item = queue->head;
+        copyPayload(payloadOf(queue, item), payload, size);
+        STATIC_QUEUE_STORE(item->active, true);
+        STATIC_QUEUE_STORE(item->pending, false);
+        staticQueueStamp(queue, item);
+        STATIC_QUEUE_STORE(queue->head, item->next);
+        payload += size;
+        pushed++;
+    }
+
+    staticQueueCountUp(queue, pushed);
+    staticQueueWriteEnd(queue);
+
+    if (pushed == 0 && num_items > 0) {
+        return STATIC_QUEUE_FULL;
+    }
+
+    STATIC_QUEUE_TRACE_OP(queue, STATIC_QUEUE_TRACE_UNSUPPORTED, NULL);
+
+    return pushed;
+}
+
+int32_t staticQueueTakeMany(staticQueue_t* queue, void* dst, uint32_t num_items)
+{
+    if (queue == NULL || dst == NULL || queue->payload_size == 0) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    uint8_t* payload = dst;
+    uint32_t size    = queue->payload_size;
+    uint32_t taken   = 0;
+
+    staticQueueWriteBegin(queue);
+    while (taken < num_items && !staticQueueEmpty(queue) &&
+           !__atomic_load_n(&queue->tail->pending, __ATOMIC_ACQUIRE)) {
+        staticQueueItem_t* item = queue->tail;
+        copyPayload(payload, payloadOf(queue, item), size);
+        STATIC_QUEUE_STORE(item->active, false);
+        STATIC_QUEUE_STORE(queue->tail, item->next);
+        payload += size;
+        taken++;
+    }
+
+    staticQueueCountDown(queue, taken);
+    staticQueueWriteEnd(queue);
+
+    if (taken == 0 && num_items > 0) {
         return STATIC_QUEUE_EMPTY;
     }
 
-    *pop_item           = queue->tail;
-    queue->tail->active = false;
-    queue->tail         = queue->tail->next;
+    STATIC_QUEUE_TRACE_OP(queue, STATIC_QUEUE_TRACE_UNSUPPORTED, NULL);
+
+    return taken;
+}
+
+int32_t staticQueueSetTimestamp(staticQueue_t*     queue,
+                                uint32_t           stamp_offset,
+                                staticQueueClock_t clock,
+                                void*              clock_ctx)
+{
+    if (queue == NULL || (clock != NULL && stamp_offset < sizeof(uint64_t))) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    queue->stamp_offset = stamp_offset;
+    queue->clock        = clock;
+    queue->clock_ctx    = clock_ctx;
 
     return STATIC_QUEUE_SUCCESS;
 }
 
-int32_t staticQueuePeak(staticQueue_t* queue, staticQueueItem_t** peak_item) {
+int32_t staticQueueExpire(staticQueue_t*      queue,
+                          uint64_t            now,
+                          uint64_t            ttl,
+                          staticQueueItem_t** expired,
+                          uint32_t            max_items)
+{
+    if (queue == NULL || queue->stamp_offset == 0) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    uint32_t num_expired = 0;
+
+    // Pop from the front until the first item that is still alive, or reserved. A stamp later than
+    // now, when now was read before the put, is alive, the unsigned age would wrap around.
+    staticQueueWriteBegin(queue);
+    while (num_expired < max_items && !staticQueueEmpty(queue) &&
+           !__atomic_load_n(&queue->tail->pending, __ATOMIC_ACQUIRE) &&
+           *staticQueueStampOf(queue, queue->tail) <= now &&
+           now - *staticQueueStampOf(queue, queue->tail) >= ttl) {
+        staticQueueItem_t* item = queue->tail;
+        STATIC_QUEUE_STORE(item->active, false);
+        STATIC_QUEUE_STORE(queue->tail, item->next);
+        if (expired != NULL) {
+            expired[num_expired] = item;
+        }
+        num_expired++;
+        STATIC_QUEUE_TRACE_OP(queue, STATIC_QUEUE_TRACE_POP, item);
+    }
+
+    staticQueueCountDown(queue, num_expired);
+    staticQueueWriteEnd(queue);
+
+    return num_expired;
+}
+
+int32_t staticQueuePopLast(staticQueue_t* queue, staticQueueItem_t** pop_item)
+{
     if (staticQueueEmpty(queue)) {
         return STATIC_QUEUE_EMPTY;
     }
 
-    *peak_item = queue->tail;
+    staticQueueItem_t* last = queue->head->last;
+    if (__atomic_load_n(&last->pending, __ATOMIC_ACQUIRE)) {
+        return STATIC_QUEUE_EMPTY;
+    }
+
+    // Move the head one step back, this is the inverse of Put
+    staticQueueWriteBegin(queue);
+    *pop_item    = last;
+    STATIC_QUEUE_STORE(last->active, false);
+    STATIC_QUEUE_STORE(queue->head, last);
+    staticQueueCountDown(queue, 1);
+    staticQueueWriteEnd(queue);
+    STATIC_QUEUE_TRACE_OP(queue, STATIC_QUEUE_TRACE_POP_LAST, last);
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticQueueAt(staticQueue_t* queue, uint32_t position, staticQueueItem_t** item)
+{
+    if (queue == NULL || item == NULL) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    if (position >= queue->num_items) {
+        return STATIC_QUEUE_NOT_IN_QUEUE;
+    }
+
+    staticQueueItem_t* current;
+    if (queue->in_order) {
+        uint32_t index = slotIndex(queue, queue->tail) + position;
+        if (index >= queue->queue_length) {
+            index -= queue->queue_length;
+        }
+        current = slotAt(queue, index);
+    } else if (position <= queue->num_items / 2) {
+        current = queue->tail;
+        for (uint32_t i = 0; i < position; i++) {
+            current = current->next;
+        }
+    } else {
+        // Also right for a full queue, head is the tail and head->last the newest item
+        current = queue->head->last;
+        for (uint32_t i = position + 1; i < queue->num_items; i++) {
+            current = current->last;
+        }
+    }
+
+    if (__atomic_load_n(&current->pending, __ATOMIC_ACQUIRE)) {
+        return STATIC_QUEUE_EMPTY;
+    }
+
+    *item = current;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticQueuePeekN(staticQueue_t* queue, staticQueueItem_t** items, uint32_t max_items)
+{
+    if (queue == NULL || items == NULL) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    uint32_t           num     = 0;
+    uint32_t           limit   = max_items < queue->num_items ? max_items : queue->num_items;
+    staticQueueItem_t* current = queue->tail;
+    staticQueueItem_t* ahead   = staticQueuePrefetchStart(current);
+
+    while (num < limit && !__atomic_load_n(&current->pending, __ATOMIC_ACQUIRE)) {
+        items[num++] = current;
+        current      = current->next;
+        ahead        = staticQueuePrefetchStep(ahead);
+    }
+
+    if (num == 0 && max_items > 0) {
+        return STATIC_QUEUE_EMPTY;
+    }
+
+    return num;
+}
+
+int32_t staticQueuePeekLast(staticQueue_t* queue, staticQueueItem_t** peek_item)
+{
+    if (staticQueueEmpty(queue) || __atomic_load_n(&queue->head->last->pending, __ATOMIC_ACQUIRE)) {
+        return STATIC_QUEUE_EMPTY;
+    }
+
+    *peek_item = queue->head->last;
 
     return STATIC_QUEUE_SUCCESS;
 }
 
 int32_t staticQueueClear(staticQueue_t* queue)
 {
-    queue->head = queue->first_item;
+    staticQueueWriteBegin(queue);
+    STATIC_QUEUE_STORE(queue->head, queue->first_item);
     for (uint32_t i = 0; i < queue->queue_length; i++) {
-        queue->head->active = false;
-        queue->head         = queue->head->next;
+        STATIC_QUEUE_STORE(queue->head->active, false);
+        STATIC_QUEUE_STORE(queue->head->pending, false);
+        STATIC_QUEUE_STORE(queue->head, queue->head->next);
     }
 
-    queue->head = queue->first_item;
-    queue->tail = queue->first_item;
+    STATIC_QUEUE_STORE(queue->head, queue->first_item);
+    STATIC_QUEUE_STORE(queue->tail, queue->first_item);
+    staticQueueCountDown(queue, queue->num_items);
+    staticQueueWriteEnd(queue);
+    STATIC_QUEUE_TRACE_OP(queue, STATIC_QUEUE_TRACE_CLEAR, NULL);
     return STATIC_QUEUE_SUCCESS;
 }
 
-int32_t staticQueueErase(staticQueue_t* queue, staticQueueItem_t* item)
+static int32_t moveLast(staticQueue_t* queue, staticQueueItem_t* item)
+{
+    // Already the newest item, this also covers a queue with one item
+    if (item == queue->head->last) {
+        return STATIC_QUEUE_SUCCESS;
+    }
+
+    if (item == queue->tail) {
+        STATIC_QUEUE_STORE(queue->tail, item->next);
+
+        // In a full queue the ring order is already right, the oldest simply becomes the newest
+        if (queue->head == item) {
+            STATIC_QUEUE_STORE(queue->head, queue->tail);
+            return STATIC_QUEUE_SUCCESS;
+        }
+    }
+
+    // Unlink and insert before head, in a full queue head is the tail so this is still the end
+    queue->in_order  = false;
+    item->last->next = item->next;
+    item->next->last = item->last;
+
+    item->next              = queue->head;
+    item->last              = queue->head->last;
+    queue->head->last->next = item;
+    queue->head->last       = item;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticQueueMoveLast(staticQueue_t* queue, staticQueueItem_t* item)
+{
+    if (!item->active) {
+        return STATIC_QUEUE_NOT_IN_QUEUE;
+    }
+
+    staticQueueWriteBegin(queue);
+    int32_t result = moveLast(queue, item);
+    staticQueueWriteEnd(queue);
+    STATIC_QUEUE_TRACE_OP(queue, STATIC_QUEUE_TRACE_MOVE_LAST, item);
+
+    return result;
+}
+
+static int32_t eraseItem(staticQueue_t* queue, staticQueueItem_t* item)
 {
     // Check if the item is active
     if (!item->active) {
         return STATIC_QUEUE_EMPTY;
     }
 
-    // Mark the item as inactive
-    item->active = false;
+    // Mark the item as inactive, this also drops a pending reservation
+    STATIC_QUEUE_STORE(item->active, false);
+    STATIC_QUEUE_STORE(item->pending, false);
 
     // Special case: if this was the only item in the queue
     if (queue->tail == queue->head->last && queue->tail == item) {
         // Queue is now empty, reset pointers
-        queue->head = queue->first_item;
-        queue->tail = queue->first_item;
+        STATIC_QUEUE_STORE(queue->head, queue->first_item);
+        STATIC_QUEUE_STORE(queue->tail, queue->first_item);
         return STATIC_QUEUE_SUCCESS;
     } else if (item == queue->tail) {
         // If erasing the tail item (oldest item), just move tail to next
-        queue->tail = queue->tail->next;
+        STATIC_QUEUE_STORE(queue->tail, queue->tail->next);
 
         // Skip over any remaining inactive items at tail
         while (queue->tail != queue->head && !queue->tail->active) {
-            queue->tail = queue->tail->next;
+            STATIC_QUEUE_STORE(queue->tail, queue->tail->next);
         }
 
         // Check if tail caught up to head with exactly one active item
         if (queue->tail == queue->head && queue->tail->active) {
             // Move head forward to maintain tail != head invariant for single item
-            queue->head = queue->head->next;
+            STATIC_QUEUE_STORE(queue->head, queue->head->next);
         }
 
         return STATIC_QUEUE_SUCCESS;
     } else if (item->next == queue->head) {
         // If erasing the item just before head (newest item), move head backward
-        queue->head = item;
+        STATIC_QUEUE_STORE(queue->head, item);
 
         // Check if head caught up to tail with exactly one active item
         if (queue->tail == queue->head && queue->tail->active) {
             // Move head forward to maintain tail != head invariant for single item
-            queue->head = queue->head->next;
+            STATIC_QUEUE_STORE(queue->head, queue->head->next);
         }
 
         return STATIC_QUEUE_SUCCESS;
@@ -194,6 +655,7 @@ int32_t staticQueueErase(staticQueue_t* queue, staticQueueItem_t* item)
 
     prev_item->next = next_item;
     next_item->last = prev_item;
+    queue->in_order = false;
 
     // Step 2: Reinsert the item immediately before tail
     staticQueueItem_t* before_tail = queue->tail->last;
@@ -206,47 +668,225 @@ int32_t staticQueueErase(staticQueue_t* queue, staticQueueItem_t* item)
 
     // Step 3: If queue was full, move head to point to the erased item (now inactive)
     if (queue->head == queue->tail && queue->head->active) {
-        queue->head = item;
+        STATIC_QUEUE_STORE(queue->head, item);
     }
 
     return STATIC_QUEUE_SUCCESS;
 }
 
-int32_t staticQueueGetNumItems(staticQueue_t* queue)
+static int32_t eraseIf(staticQueue_t* queue, staticQueuePredicate_t predicate, void* ctx)
 {
-    if (queue == NULL) {
-        return STATIC_QUEUE_EMPTY;
+    if (staticQueueEmpty(queue)) {
+        return 0;
     }
 
-    if (staticQueueEmpty(queue)) {
+    // The ring is split in three chains: kept items, erased items and the free items that were
+    // already between head and tail. They are relinked in that order, so the erased items end up
+    // directly after the last kept item, at the new head.
+    staticQueueItem_t* kept_first   = NULL;
+    staticQueueItem_t* kept_last    = NULL;
+    staticQueueItem_t* erased_first = NULL;
+    staticQueueItem_t* erased_last  = NULL;
+    staticQueueItem_t* free_first   = NULL;
+    staticQueueItem_t* free_last    = NULL;
+
+    if (!staticQueuefull(queue)) {
+        free_first = queue->head;
+        free_last  = queue->tail->last;
+    }
+
+    staticQueueItem_t* current = queue->tail;
+    staticQueueItem_t* end     = queue->head;
+    int32_t            erased  = 0;
+
+    do {
+        staticQueueItem_t* next = current->next;
+
+        bool keep = current->active &&
+                    (current->pending || !predicate(queue, current, ctx));
+        if (keep) {
+            if (kept_first == NULL) {
+                kept_first = current;
+            } else {
+                kept_last->next = current;
+                current->last   = kept_last;
+            }
+            kept_last = current;
+        } else {
+            if (current->active) {
+                STATIC_QUEUE_STORE(current->active, false);
+                erased++;
+            }
+            if (erased_first == NULL) {
+                erased_first = current;
+            } else {
+                erased_last->next = current;
+                current->last     = erased_last;
+            }
+            erased_last = current;
+        }
+
+        current = next;
+    } while (current != end);
+
+    if (erased_first == NULL) {
+        // Nothing was unlinked, the chain is intact
         return 0;
     }
 
-    // Check if queue is full
-    if (staticQueuefull(queue)) {
-        return queue->queue_length;
+    // Splice the chains back together into one ring: kept -> erased -> free -> kept
+    queue->in_order = false;
+    staticQueueItem_t* ring_first = kept_first != NULL ? kept_first : erased_first;
+    staticQueueItem_t* ring_last  = free_last != NULL ? free_last : erased_last;
+
+    if (kept_last != NULL) {
+        kept_last->next    = erased_first;
+        erased_first->last = kept_last;
     }
 
-    // Count active items from tail to head
-    int32_t count = 0;
-    staticQueueItem_t *current = queue->tail;
+    if (free_first != NULL) {
+        erased_last->next = free_first;
+        free_first->last  = erased_last;
+    }
 
-    while (current != queue->head) {
-        if (current->active) {
-            count++;
+    ring_last->next  = ring_first;
+    ring_first->last = ring_last;
+
+    STATIC_QUEUE_STORE(queue->tail, ring_first);
+    STATIC_QUEUE_STORE(queue->head, erased_first);
+    staticQueueCountDown(queue, erased);
+
+    return erased;
+}
+
+int32_t staticQueueEraseIf(staticQueue_t* queue, staticQueuePredicate_t predicate, void* ctx)
+{
+    if (queue == NULL || predicate == NULL) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    staticQueueWriteBegin(queue);
+    int32_t erased = eraseIf(queue, predicate, ctx);
+    staticQueueWriteEnd(queue);
+    STATIC_QUEUE_TRACE_OP(queue, STATIC_QUEUE_TRACE_UNSUPPORTED, NULL);
+
+    return erased;
+}
+
+int32_t staticQueueErase(staticQueue_t* queue, staticQueueItem_t* item)
+{
+    staticQueueWriteBegin(queue);
+    int32_t result = eraseItem(queue, item);
+    if (result == STATIC_QUEUE_SUCCESS) {
+        staticQueueCountDown(queue, 1);
+    }
+    staticQueueWriteEnd(queue);
+
+    if (result == STATIC_QUEUE_SUCCESS) {
+        STATIC_QUEUE_TRACE_OP(queue, STATIC_QUEUE_TRACE_ERASE, item);
+    }
+
+    return result;
+}
+
+int32_t staticQueueCompact(staticQueue_t* queue, staticQueueSwapCb_t swap, void* ctx)
+{
+    if (queue == NULL || swap == NULL) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    bool full = staticQueuefull(queue);
+
+    // Payloads being filled by a producer can not be moved
+    staticQueueItem_t* current = queue->tail;
+    uint32_t           num_items = 0;
+    while (full ? num_items < queue->queue_length : current != queue->head) {
+        if (current->pending) {
+            return STATIC_QUEUE_INVALID;
         }
         current = current->next;
+        num_items++;
+    }
+
+    // The links are rebuilt below, so the last pointer is free to hold the target slot of
+    // each node. Walking the whole ring from tail assigns the active items to the first slots.
+    staticQueueWriteBegin(queue);
+    current = queue->tail;
+    for (uint32_t i = 0; i < queue->queue_length; i++) {
+        staticQueueItem_t* next = current->next;
+        current->last           = slotAt(queue, i);
+        current                 = next;
+    }
+
+    // Follow the permutation cycles, each swap puts one payload in its final slot
+    int32_t swaps = 0;
+    for (uint32_t i = 0; i < queue->queue_length; i++) {
+        staticQueueItem_t* slot = slotAt(queue, i);
+        while (slot->last != slot) {
+            staticQueueItem_t* target = slot->last;
+
+            swap(slot, target, ctx);
+            swaps++;
+
+            bool active    = slot->active;
+            STATIC_QUEUE_STORE(slot->active, target->active);
+            STATIC_QUEUE_STORE(target->active, active);
+            slot->last     = target->last;
+            target->last   = target;
+        }
     }
 
-    return count;
+    // Link the slots in array order again
+    for (uint32_t i = 0; i < queue->queue_length; i++) {
+        staticQueueItem_t* item = slotAt(queue, i);
+        item->next              = slotAt(queue, (i + 1) % queue->queue_length);
+        item->next->last        = item;
+    }
+
+    STATIC_QUEUE_STORE(queue->tail, queue->first_item);
+    STATIC_QUEUE_STORE(queue->head, slotAt(queue, num_items % queue->queue_length));
+    queue->in_order = true;
+    staticQueueWriteEnd(queue);
+    STATIC_QUEUE_TRACE_OP(queue, STATIC_QUEUE_TRACE_UNSUPPORTED, NULL);
+
+    return swaps;
 }
 
-int32_t staticQueueForEach(staticQueue_t* queue, int32_t (*callback)(staticQueue_t *queue, staticQueueItem_t *item))
+int32_t staticQueueGetNumItems(staticQueue_t* queue)
 {
-    if (queue == NULL || callback == NULL) {
+    if (queue == NULL) {
         return STATIC_QUEUE_EMPTY;
     }
 
+    return queue->num_items;
+}
+
+int32_t staticQueueSetWatermarks(staticQueue_t*           queue,
+                                 uint32_t                 high,
+                                 uint32_t                 low,
+                                 staticQueueWatermarkCb_t callback,
+                                 void*                    ctx)
+{
+    if (queue == NULL || (high != 0 && low >= high)) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    queue->high_watermark  = high;
+    queue->low_watermark   = low;
+    queue->watermark_cb    = callback;
+    queue->watermark_ctx   = ctx;
+    queue->above_watermark = high != 0 && queue->num_items >= high;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+bool staticQueueAboveWatermark(staticQueue_t* queue)
+{
+    return queue->above_watermark;
+}
+
+static int32_t forEachItem(staticQueue_t* queue, staticQueueCallback_t callback, void* ctx)
+{
     if (staticQueueEmpty(queue)) {
         return STATIC_QUEUE_SUCCESS;
     }
@@ -258,19 +898,26 @@ int32_t staticQueueForEach(staticQueue_t* queue, int32_t (*callback)(staticQueue
     }
 
     staticQueueItem_t *current = queue->tail;
+    staticQueueItem_t *ahead = staticQueuePrefetchStart(current);
     int32_t processed = 0;
 
     // Process exactly num_items active items
     while (processed < num_items) {
-        // Only process active items
-        if (current->active) {
-            int32_t cb_res = callback(queue, current);
+        ahead = staticQueuePrefetchStep(ahead);
+
+        // Reserved items are not visible until committed
+        if (current->active && current->pending) {
+            current = current->next;
+            processed++;
+        } else if (current->active) {
+            int32_t cb_res = callback(queue, current, ctx);
             switch(cb_res) {
                 case STATIC_QUEUE_CB_NEXT:
                     current = current->next;
                     processed++;
                     break;
                 case STATIC_QUEUE_CB_STOP:
+                    STATIC_QUEUE_TRACE_OP(queue, STATIC_QUEUE_TRACE_FOREACH_STOP, current);
                     return STATIC_QUEUE_SUCCESS;
                 case STATIC_QUEUE_CB_ERASE: {
                     staticQueueItem_t *tmp = current;
@@ -295,3 +942,315 @@ int32_t staticQueueForEach(staticQueue_t* queue, int32_t (*callback)(staticQueue
 
     return STATIC_QUEUE_SUCCESS;
 }
+
+int32_t staticQueueForEachCtx(staticQueue_t* queue, staticQueueCallback_t callback, void* ctx)
+{
+    if (queue == NULL || callback == NULL) {
+        return STATIC_QUEUE_EMPTY;
+    }
+
+    // The erases made by the callback are recorded between these two
+    STATIC_QUEUE_TRACE_OP(queue, STATIC_QUEUE_TRACE_FOREACH, NULL);
+    int32_t result = forEachItem(queue, callback, ctx);
+    STATIC_QUEUE_TRACE_OP(queue, STATIC_QUEUE_TRACE_FOREACH_END, NULL);
+
+    return result;
+}
+
+static int32_t forEachNoCtx(staticQueue_t* queue, staticQueueItem_t* item, void* ctx)
+{
+    int32_t (*callback)(staticQueue_t*, staticQueueItem_t*) =
+        *(int32_t (**)(staticQueue_t*, staticQueueItem_t*))ctx;
+    return callback(queue, item);
+}
+
+int32_t staticQueueForEach(staticQueue_t* queue, int32_t (*callback)(staticQueue_t *queue, staticQueueItem_t *item))
+{
+    if (callback == NULL) {
+        return STATIC_QUEUE_EMPTY;
+    }
+
+    return staticQueueForEachCtx(queue, forEachNoCtx, &callback);
+}
+
+int32_t staticQueueFind(staticQueue_t*         queue,
+                        staticQueuePredicate_t predicate,
+                        void*                  ctx,
+                        staticQueueItem_t**    found_item)
+{
+    if (queue == NULL || predicate == NULL || found_item == NULL) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    // Nothing matches in an empty queue
+    if (staticQueueEmpty(queue)) {
+        return STATIC_QUEUE_NOT_IN_QUEUE;
+    }
+
+    // Walk from tail to head and stop at the first match
+    staticQueueItem_t* current = queue->tail;
+    do {
+        if (current->active && !current->pending && predicate(queue, current, ctx)) {
+            *found_item = current;
+            return STATIC_QUEUE_SUCCESS;
+        }
+        current = current->next;
+    } while (current != queue->head);
+
+    return STATIC_QUEUE_NOT_IN_QUEUE;
+}
+
+#if STATIC_QUEUE_SEQLOCK
+// Wait until the writer is not inside an operation, the version is even then
+static inline uint32_t readBegin(staticQueue_t* queue)
+{
+    uint32_t version;
+    while ((version = __atomic_load_n(&queue->version, __ATOMIC_ACQUIRE)) & 1u) {
+    }
+
+    return version;
+}
+
+// True if no write overlapped the reads since readBegin
+static inline bool readValid(staticQueue_t* queue, uint32_t version)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&queue->version, __ATOMIC_RELAXED) == version;
+}
+
+int32_t staticQueueSnapshot(staticQueue_t* queue, staticQueueSnapshot_t* snapshot)
+{
+    if (queue == NULL || snapshot == NULL) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    uint32_t version;
+    do {
+        version             = readBegin(queue);
+        snapshot->head      = __atomic_load_n(&queue->head, __ATOMIC_RELAXED);
+        snapshot->tail      = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+        snapshot->num_items = __atomic_load_n(&queue->num_items, __ATOMIC_RELAXED);
+    } while (!readValid(queue, version));
+
+    snapshot->version = version;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticQueuePeekCopy(staticQueue_t* queue, void* dst)
+{
+    if (queue == NULL || dst == NULL || queue->payload_size == 0) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    for (;;) {
+        uint32_t           version = readBegin(queue);
+        staticQueueItem_t* tail    = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+
+        // The tail is only inactive in an empty queue. The acquire pairs with Commit, a
+        // committed payload is complete.
+        bool visible = __atomic_load_n(&tail->active, __ATOMIC_RELAXED) &&
+                       !__atomic_load_n(&tail->pending, __ATOMIC_ACQUIRE);
+        if (visible) {
+            copyPayload(dst, payloadOf(queue, tail), queue->payload_size);
+        }
+
+        if (readValid(queue, version)) {
+            return visible ? STATIC_QUEUE_SUCCESS : STATIC_QUEUE_EMPTY;
+        }
+    }
+}
+#endif
+
+#if STATIC_QUEUE_TRACE
+int32_t staticQueueTraceStart(staticQueue_t*      queue,
+                              staticQueueTrace_t* trace,
+                              uint32_t*           records,
+                              uint32_t            capacity)
+{
+    if (queue == NULL || trace == NULL || records == NULL || capacity == 0) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    if (!staticQueueEmpty(queue)) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    // A replay starts from a freshly initialized queue, so the ring must still be in array order
+    staticQueueItem_t* item = queue->first_item;
+    for (uint32_t i = 0; i < queue->queue_length; i++) {
+        if (item->next != slotAt(queue, (i + 1) % queue->queue_length)) {
+            return STATIC_QUEUE_INVALID;
+        }
+        item = item->next;
+    }
+
+    trace->records      = records;
+    trace->capacity     = capacity;
+    trace->num_records  = 0;
+    trace->queue_length = queue->queue_length;
+    trace->dropped      = 0;
+    trace->unsupported  = 0;
+
+    queue->trace = trace;
+    staticQueueTraceRecord(queue, STATIC_QUEUE_TRACE_START, queue->head);
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticQueueTraceStop(staticQueue_t* queue)
+{
+    if (queue == NULL) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    queue->trace = NULL;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+void staticQueueTraceRecord(staticQueue_t* queue, uint32_t op, staticQueueItem_t* item)
+{
+    staticQueueTrace_t* trace = queue->trace;
+
+    if (op == STATIC_QUEUE_TRACE_UNSUPPORTED) {
+        trace->unsupported++;
+        return;
+    }
+
+    if (trace->num_records == trace->capacity) {
+        trace->dropped++;
+        return;
+    }
+
+    uint32_t index = item != NULL ? slotIndex(queue, item) : 0;
+    trace->records[trace->num_records++] = STATIC_QUEUE_TRACE_RECORD(op, index);
+}
+#endif
+
+typedef struct {
+    const uint32_t*       records;
+    uint32_t              num_records;
+    uint32_t              pos;
+    staticQueueCallback_t visit;
+    void*                 ctx;
+} replayCursor_t;
+
+// Erase or stop where the recorded callback did, the next record says which
+static int32_t replayForEach(staticQueue_t* queue, staticQueueItem_t* item, void* ctx)
+{
+    replayCursor_t* cursor = ctx;
+
+    if (cursor->visit != NULL) {
+        int32_t result = cursor->visit(queue, item, cursor->ctx);
+        if (result < 0) {
+            return result;
+        }
+    }
+
+    if (cursor->pos < cursor->num_records) {
+        uint32_t record = cursor->records[cursor->pos];
+        if (STATIC_QUEUE_TRACE_RECORD_INDEX(record) == slotIndex(queue, item)) {
+            switch (STATIC_QUEUE_TRACE_RECORD_OP(record)) {
+                case STATIC_QUEUE_TRACE_ERASE:
+                    cursor->pos++;
+                    return STATIC_QUEUE_CB_ERASE;
+                case STATIC_QUEUE_TRACE_FOREACH_STOP:
+                    cursor->pos++;
+                    return STATIC_QUEUE_CB_STOP;
+                default:
+                    break;
+            }
+        }
+    }
+
+    return STATIC_QUEUE_CB_NEXT;
+}
+
+int32_t staticQueueTraceReplay(staticQueue_t*        queue,
+                               const uint32_t*       records,
+                               uint32_t              num_records,
+                               staticQueueCallback_t visit,
+                               void*                 ctx)
+{
+    if (queue == NULL || records == NULL || num_records == 0) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    if (STATIC_QUEUE_TRACE_RECORD_OP(records[0]) != STATIC_QUEUE_TRACE_START ||
+        STATIC_QUEUE_TRACE_RECORD_INDEX(records[0]) >= queue->queue_length || !staticQueueEmpty(queue)) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    // An empty queue in array order can start anywhere in the ring
+    queue->head = slotAt(queue, STATIC_QUEUE_TRACE_RECORD_INDEX(records[0]));
+    queue->tail = queue->head;
+
+    replayCursor_t cursor = {records, num_records, 1, visit, ctx};
+    while (cursor.pos < num_records) {
+        uint32_t record = records[cursor.pos++];
+        uint32_t index  = STATIC_QUEUE_TRACE_RECORD_INDEX(record);
+        if (index >= queue->queue_length) {
+            return STATIC_QUEUE_INVALID;
+        }
+
+        staticQueueItem_t* expected = slotAt(queue, index);
+        staticQueueItem_t* item     = NULL;
+        int32_t            result   = STATIC_QUEUE_SUCCESS;
+
+        switch (STATIC_QUEUE_TRACE_RECORD_OP(record)) {
+            case STATIC_QUEUE_TRACE_PUT:
+                result = staticQueuePut(queue, &item);
+                break;
+            case STATIC_QUEUE_TRACE_PUT_FIRST:
+                result = staticQueuePutFirst(queue, &item);
+                break;
+            case STATIC_QUEUE_TRACE_PUT_AFTER:
+                result   = staticQueuePutAfter(queue, expected, &item);
+                expected = item;
+                break;
+            case STATIC_QUEUE_TRACE_POP:
+                result = staticQueuePop(queue, &item);
+                break;
+            case STATIC_QUEUE_TRACE_POP_LAST:
+                result = staticQueuePopLast(queue, &item);
+                break;
+            case STATIC_QUEUE_TRACE_ERASE:
+                result = staticQueueErase(queue, expected);
+                break;
+            case STATIC_QUEUE_TRACE_MOVE_LAST:
+                result = staticQueueMoveLast(queue, expected);
+                break;
+            case STATIC_QUEUE_TRACE_CLEAR:
+                result = staticQueueClear(queue);
+                break;
+            case STATIC_QUEUE_TRACE_FOREACH:
+                result = staticQueueForEachCtx(queue, replayForEach, &cursor);
+                // A trace that ran out of space may end inside the iteration
+                if (result == STATIC_QUEUE_SUCCESS && cursor.pos < num_records) {
+                    if (STATIC_QUEUE_TRACE_RECORD_OP(records[cursor.pos]) != STATIC_QUEUE_TRACE_FOREACH_END) {
+                        return STATIC_QUEUE_INVALID;
+                    }
+                    cursor.pos++;
+                }
+                break;
+            default:
+                return STATIC_QUEUE_INVALID;
+        }
+
+        if (result != STATIC_QUEUE_SUCCESS) {
+            return result;
+        }
+
+        if (item != NULL) {
+            if (item != expected) {
+                return STATIC_QUEUE_INVALID;
+            }
+            if (visit != NULL && (result = visit(queue, item, ctx)) < 0) {
+                return result;
+            }
+        }
+    }
+
+    return (int32_t)cursor.pos;
+}
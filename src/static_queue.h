@@ -77,12 +77,66 @@
 #define CONTAINER_OF(ptr, type, member)	(type *)((char *)(ptr) - offsetof(type,member))
 #endif
 
+/**
+ * Optional software prefetching on traversals and Pop. When the ring order has been scrambled by
+ * middle erases, every hop is a dependent cache miss. With a distance > 0 the node that many
+ * steps ahead is prefetched while the current node is processed. Pop only prefetches the new
+ * front item, following its links would stall on the same misses. Payload lines are prefetched
+ * from in front of the node, which matches the layout where the staticQueueItem_t is the last
+ * member of the item struct. Define these for the static_queue sources, e.g. with
+ * target_compile_definitions.
+ */
+#ifndef STATIC_QUEUE_PREFETCH_DISTANCE
+#define STATIC_QUEUE_PREFETCH_DISTANCE 0
+#endif
+
+#ifndef STATIC_QUEUE_PREFETCH_PAYLOAD_LINES
+#define STATIC_QUEUE_PREFETCH_PAYLOAD_LINES 1
+#endif
+
+#ifndef STATIC_QUEUE_CACHE_LINE_SIZE
+#define STATIC_QUEUE_CACHE_LINE_SIZE 64
+#endif
+
+/**
+ * Define STATIC_QUEUE_INLINE to get Put, Pop, Peak, full and Empty as static inline functions
+ * in every translation unit that includes this header, instead of calls into static_queue.c.
+ * Without LTO this is the only way they are inlined. Define it for the static_queue sources
+ * and all their users alike, e.g. with target_compile_definitions.
+ */
+#ifdef STATIC_QUEUE_INLINE
+#define STATIC_QUEUE_HOT static inline
+#else
+#define STATIC_QUEUE_HOT
+#endif
+
+/**
+ * Define STATIC_QUEUE_TRACE=1 to be able to record every operation on a queue into a static
+ * buffer, see staticQueueTraceStart. Without it the hooks compile to nothing. A recorded trace
+ * is replayed with staticQueueTraceReplay, which is always available, so the same trace can be
+ * run against builds with other queue options.
+ */
+#ifndef STATIC_QUEUE_TRACE
+#define STATIC_QUEUE_TRACE 0
+#endif
+
+/**
+ * Define STATIC_QUEUE_SEQLOCK=1 to let other threads read the queue state while one writer keeps
+ * changing it, without taking the writer's lock. Every operation that changes the queue bumps a
+ * version counter before and after, see staticQueueSnapshot.
+ */
+#ifndef STATIC_QUEUE_SEQLOCK
+#define STATIC_QUEUE_SEQLOCK 0
+#endif
+
 // Package queue
 typedef enum {
     STATIC_QUEUE_SUCCESS      = 0,
     STATIC_QUEUE_FULL         = -401,
     STATIC_QUEUE_EMPTY        = -402,
     STATIC_QUEUE_NOT_IN_QUEUE = -403,
+    STATIC_QUEUE_INVALID      = -404,
+    STATIC_QUEUE_IO_ERROR     = -405, // A system call failed, errno is kept
 } queueErr_t;
 
 typedef enum {
@@ -91,20 +145,127 @@ typedef enum {
     STATIC_QUEUE_CB_ERASE,     // Erase this node and keep iterating
 } staticQueueCbDo_t;
 
+/**
+ * Trace records are one uint32_t each, the operation in the low 4 bits and the array index of
+ * the item it returned or took in the upper 28 bits
+ */
+typedef enum {
+    STATIC_QUEUE_TRACE_START = 0,    // Index is where head and tail start
+    STATIC_QUEUE_TRACE_PUT,          // Index is the item returned
+    STATIC_QUEUE_TRACE_PUT_FIRST,    // Index is the item returned
+    STATIC_QUEUE_TRACE_PUT_AFTER,    // Index is the position, the new item follows from the state
+    STATIC_QUEUE_TRACE_POP,          // Index is the item returned
+    STATIC_QUEUE_TRACE_POP_LAST,     // Index is the item returned
+    STATIC_QUEUE_TRACE_ERASE,        // Index is the erased item
+    STATIC_QUEUE_TRACE_MOVE_LAST,    // Index is the moved item
+    STATIC_QUEUE_TRACE_CLEAR,
+    STATIC_QUEUE_TRACE_FOREACH,      // Erases until FOREACH_END are made by the callback
+    STATIC_QUEUE_TRACE_FOREACH_STOP, // Index is the item the callback stopped on
+    STATIC_QUEUE_TRACE_FOREACH_END,
+    STATIC_QUEUE_TRACE_UNSUPPORTED,  // Never stored, only counted
+} staticQueueTraceOp_t;
+
+#define STATIC_QUEUE_TRACE_RECORD(op, index) (((uint32_t)(index) << 4) | (uint32_t)(op))
+#define STATIC_QUEUE_TRACE_RECORD_OP(record) ((record) & 0xFu)
+#define STATIC_QUEUE_TRACE_RECORD_INDEX(record) ((record) >> 4)
+
 typedef struct staticQueueItem staticQueueItem_t;
 
 struct staticQueueItem {
     staticQueueItem_t* next;
     staticQueueItem_t* last;
     bool               active;
+    bool               pending; // Reserved but not yet committed, not visible to Pop/Peak
 };
 
+typedef struct staticQueue staticQueue_t;
+
+/**
+ * Clock used to stamp items when they are put, any monotonic unit works as long as the expire
+ * calls use the same
+ */
+typedef uint64_t (*staticQueueClock_t)(void* ctx);
+
+/**
+ * Predicate used to select items, return true if the item matches
+ */
+typedef bool (*staticQueuePredicate_t)(staticQueue_t* queue, staticQueueItem_t* item, void* ctx);
+
+/**
+ * Callback used when iterating with a user context, returns a staticQueueCbDo_t or a negative
+ * error code that stops the iteration
+ */
+typedef int32_t (*staticQueueCallback_t)(staticQueue_t* queue, staticQueueItem_t* item, void* ctx);
+
+/**
+ * Callback used to exchange the user payload of two items, the staticQueueItem_t members must
+ * be left untouched
+ */
+typedef void (*staticQueueSwapCb_t)(staticQueueItem_t* a, staticQueueItem_t* b, void* ctx);
+
+/**
+ * Callback fired when the number of items crosses a watermark, high is true when the high
+ * watermark is reached and false when the count has fallen back to the low watermark
+ */
+typedef void (*staticQueueWatermarkCb_t)(staticQueue_t* queue, bool high, void* ctx);
+
+/**
+ * Trace buffer, when it is full recording stops and the rest is counted as dropped so that the
+ * stored trace always replays from its start
+ */
 typedef struct {
+    uint32_t* records;
+    uint32_t  capacity;
+    uint32_t  num_records;
+    uint32_t  queue_length; // Length of the traced queue, a replay queue must have the same
+    uint32_t  dropped;      // Operations not stored because the buffer was full
+    uint32_t  unsupported;  // Operations that can not be replayed, Reserve, EraseIf, etc.
+} staticQueueTrace_t;
+
+struct staticQueue {
     staticQueueItem_t* head;
     staticQueueItem_t* tail;
     staticQueueItem_t* first_item;
     uint32_t           queue_length;
-} staticQueue_t;
+    uint32_t           node_size;
+    uint32_t           num_items;
+    bool               in_order; // The ring links still follow the array, see staticQueueAt
+
+    // Backpressure watermarks, see staticQueueSetWatermarks
+    uint32_t                 high_watermark;
+    uint32_t                 low_watermark;
+    bool                     above_watermark;
+    bool                     watermark_crossed; // Callback due at the end of the current change
+    staticQueueWatermarkCb_t watermark_cb;
+    void*                    watermark_ctx;
+
+    // Value API payload, see staticQueueSetPayload
+    uint32_t payload_offset; // Bytes from the payload start to the staticQueueItem_t
+    uint32_t payload_size;
+
+    // Insertion timestamps, see staticQueueSetTimestamp
+    uint32_t           stamp_offset; // Bytes from the uint64_t timestamp to the staticQueueItem_t
+    staticQueueClock_t clock;
+    void*              clock_ctx;
+
+#if STATIC_QUEUE_TRACE
+    staticQueueTrace_t* trace; // See staticQueueTraceStart
+#endif
+
+#if STATIC_QUEUE_SEQLOCK
+    uint32_t version; // Odd while the writer changes the queue, see staticQueueSnapshot
+#endif
+};
+
+/**
+ * Consistent view of the queue pointers, taken by a reader on another thread
+ */
+typedef struct {
+    staticQueueItem_t* head;
+    staticQueueItem_t* tail;
+    uint32_t           num_items;
+    uint32_t           version; // Changes with every write, equal versions mean an equal queue
+} staticQueueSnapshot_t;
 
 /**
  * Initialize a static queue
@@ -133,15 +294,147 @@ int32_t staticQueuePutFirst(staticQueue_t* queue, staticQueueItem_t** next_item)
  * Input: This pointer wil be populated with the pointer to the relevant item to write data to
  * Returns: queueErr_t
  */
-int32_t staticQueuePut(staticQueue_t* queue, staticQueueItem_t** next_item);
+STATIC_QUEUE_HOT int32_t staticQueuePut(staticQueue_t* queue, staticQueueItem_t** next_item);
+
+/**
+ * Put an item directly after a specific item in the queue, this is the building block for
+ * ordered queues. The position item must be in this queue, this is not verified.
+ * Input: Queue instance
+ * Input: Item to put the new item after, NULL to put it first in the queue
+ * Input: This pointer wil be populated with the pointer to the relevant item to write data to
+ * Returns: queueErr_t
+ */
+int32_t staticQueuePutAfter(staticQueue_t*      queue,
+                            staticQueueItem_t*  position,
+                            staticQueueItem_t** next_item);
+
+/**
+ * Put an item at the end of the queue, if the queue is full the oldest item is evicted and its
+ * slot reused in the same step. Use this for telemetry style queues that keep the newest items.
+ * Input: Queue instance
+ * Input: This pointer wil be populated with the pointer to the relevant item to write data to
+ * Input: This pointer will be populated with the evicted item, the same slot as next_item so
+ *        its old data can be read before it is overwritten, or NULL if nothing was evicted.
+ *        May be NULL.
+ * Returns: queueErr_t, STATIC_QUEUE_FULL if the oldest item is reserved and can not be evicted
+ */
+int32_t staticQueuePutOverwrite(staticQueue_t*      queue,
+                                staticQueueItem_t** next_item,
+                                staticQueueItem_t** evicted_item);
+
+/**
+ * Reserve an item at the end of the queue without publishing it. The item holds its place in the
+ * queue but Pop/Peak will not return it, or anything put after it, until it is committed. This
+ * makes it possible to fill the payload outside of any lock protecting the queue pointers.
+ * Input: Queue instance
+ * Input: This pointer wil be populated with the pointer to the relevant item to write data to
+ * Returns: queueErr_t
+ */
+int32_t staticQueueReserve(staticQueue_t* queue, staticQueueItem_t** next_item);
+
+/**
+ * Reserve several items at the end of the queue, see staticQueueReserve
+ * Input: Queue instance
+ * Input: Array that will be populated with the reserved items, in queue order
+ * Input: Max number of items to reserve
+ * Returns: Number of items reserved, or negative error code
+ */
+int32_t staticQueueReserveMany(staticQueue_t* queue, staticQueueItem_t** items, uint32_t num_items);
+
+/**
+ * Publish a reserved item, making it visible to Pop/Peak. Items are always pop'ed in the order
+ * they were reserved, regardless of the order they are committed in.
+ * Input: Queue instance
+ * Input: The reserved item
+ * Returns: queueErr_t
+ */
+int32_t staticQueueCommit(staticQueue_t* queue, staticQueueItem_t* item);
+
+/**
+ * Set the payload used by the value API, Push and Take copy payload_size bytes in and out of
+ * each item. Use the STATIC_QUEUE_SET_PAYLOAD macro.
+ * Input: Queue instance
+ * Input: Bytes from the start of the payload to the staticQueueItem_t, the payload must be before it
+ * Input: Size of the payload in bytes
+ * Returns: queueErr_t
+ */
+int32_t staticQueueSetPayload(staticQueue_t* queue, uint32_t payload_offset, uint32_t payload_size);
+
+/**
+ * Copy a payload into a new item at the end of the queue. The item is only put after the copy,
+ * so it is never visible half written.
+ * Input: Queue instance
+ * Input: Payload to copy in
+ * Returns: queueErr_t
+ */
+int32_t staticQueuePush(staticQueue_t* queue, const void* src);
+
+/**
+ * Copy the payload of the first item out and remove the item
+ * Input: Queue instance
+ * Input: Buffer the payload is copied to
+ * Returns: queueErr_t
+ */
+int32_t staticQueueTake(staticQueue_t* queue, void* dst);
+
+/**
+ * Push several payloads from a packed array, see staticQueuePush
+ * Input: Queue instance
+ * Input: Array of payloads, payload_size bytes each
+ * Input: Max number of payloads to push
+ * Returns: Number of payloads pushed, or negative error code
+ */
+int32_t staticQueuePushMany(staticQueue_t* queue, const void* src, uint32_t num_items);
+
+/**
+ * Take several payloads into a packed array, see staticQueueTake
+ * Input: Queue instance
+ * Input: Array for the payloads, payload_size bytes each
+ * Input: Max number of payloads to take
+ * Returns: Number of payloads taken, or negative error code
+ */
+int32_t staticQueueTakeMany(staticQueue_t* queue, void* dst, uint32_t num_items);
+
+/**
+ * Stamp every item with the clock when it is put, reserved or pushed. The timestamp is a
+ * uint64_t member of the item struct, use the STATIC_QUEUE_SET_TIMESTAMP macro.
+ * Input: Queue instance
+ * Input: Bytes from the start of the timestamp to the staticQueueItem_t, it must be before it
+ * Input: Clock, NULL stops stamping
+ * Input: User context passed to the clock
+ * Returns: queueErr_t
+ */
+int32_t staticQueueSetTimestamp(staticQueue_t*     queue,
+                                uint32_t           stamp_offset,
+                                staticQueueClock_t clock,
+                                void*              clock_ctx);
+
+/**
+ * Remove the items at the front that were put at least ttl ago. With one ttl for all items the
+ * queue is in timestamp order, so this stops at the first item that has not expired and the cost
+ * is only the number of expired items. An item put with PutFirst or PutAfter is younger than the
+ * items behind it, the sweep stops at it as well, and so does an item stamped later than now.
+ * Input: Queue instance
+ * Input: Current time, in the unit of the clock
+ * Input: Time to live
+ * Input: Array that will be populated with the expired items, in queue order, may be NULL.
+ *        Like after Pop the items can be read until they are put again.
+ * Input: Max number of items to expire
+ * Returns: Number of items expired, or negative error code
+ */
+int32_t staticQueueExpire(staticQueue_t*      queue,
+                          uint64_t            now,
+                          uint64_t            ttl,
+                          staticQueueItem_t** expired,
+                          uint32_t            max_items);
 
 /**
  * Get and remove the next Item in the queue
  * Input: Queue instance
  * Input: This pointer will be populated with the pop'ed item
- * Returns: queueErr_t
+ * Returns: queueErr_t, STATIC_QUEUE_EMPTY also if the next item is reserved but not committed
  */
-int32_t staticQueuePop(staticQueue_t* queue, staticQueueItem_t** pop_item);
+STATIC_QUEUE_HOT int32_t staticQueuePop(staticQueue_t* queue, staticQueueItem_t** pop_item);
 
 /**
  * Get the next item in the queue, but do not remove it
@@ -149,7 +442,57 @@ int32_t staticQueuePop(staticQueue_t* queue, staticQueueItem_t** pop_item);
  * Input: This pointer will be populated with the pop'ed item
  * Returns: queueErr_t
  */
-int32_t staticQueuePeak(staticQueue_t* queue, staticQueueItem_t** peak_item);
+STATIC_QUEUE_HOT int32_t staticQueuePeak(staticQueue_t* queue, staticQueueItem_t** peak_item);
+
+/**
+ * Get and remove the last item in the queue, the one most recently put. Together with Pop and
+ * PutFirst this makes the queue a full deque, and Put + PopLast makes it a LIFO stack
+ * Input: Queue instance
+ * Input: This pointer will be populated with the pop'ed item
+ * Returns: queueErr_t, STATIC_QUEUE_EMPTY also if the last item is reserved but not committed
+ */
+int32_t staticQueuePopLast(staticQueue_t* queue, staticQueueItem_t** pop_item);
+
+/**
+ * Get the item at a position in the queue, 0 is the front, without removing it. As long as the
+ * ring is in array order, no middle erases, PutAfter or MoveLast since init or Compact, this is
+ * O(1). Otherwise it walks from the nearest end, O(min(k, n - k)), call staticQueueCompact to
+ * get the O(1) case back.
+ * Input: Queue instance
+ * Input: Position, counting reserved items
+ * Input: This pointer will be populated with the item
+ * Returns: queueErr_t, STATIC_QUEUE_NOT_IN_QUEUE if there are not that many items,
+ *          STATIC_QUEUE_EMPTY if the item is reserved but not yet committed
+ */
+int32_t staticQueueAt(staticQueue_t* queue, uint32_t position, staticQueueItem_t** item);
+
+/**
+ * Get the first items in the queue, in the order Pop would return them, without removing them.
+ * Stops at the first item that is reserved but not yet committed. This walks the ring, in array
+ * order that is sequential memory, after middle erases it prefetches ahead like ForEach.
+ * Input: Queue instance
+ * Input: Array that will be populated with the items
+ * Input: Max number of items
+ * Returns: Number of items, or negative error code
+ */
+int32_t staticQueuePeekN(staticQueue_t* queue, staticQueueItem_t** items, uint32_t max_items);
+
+/**
+ * Get the last item in the queue, but do not remove it
+ * Input: Queue instance
+ * Input: This pointer will be populated with the last item
+ * Returns: queueErr_t
+ */
+int32_t staticQueuePeekLast(staticQueue_t* queue, staticQueueItem_t** peek_item);
+
+/**
+ * Move an item to the end of the queue, it will be the last pop'ed. This is O(1), the item must
+ * be in this queue, this is not verified.
+ * Input: Queue instance
+ * Input: Pointer to the item to move
+ * Returns: queueErr_t
+ */
+int32_t staticQueueMoveLast(staticQueue_t* queue, staticQueueItem_t* item);
 
 /**
  * Clear the Queue and reset the pointers
@@ -166,27 +509,76 @@ int32_t staticQueueClear(staticQueue_t* queue);
  */
 int32_t staticQueueErase(staticQueue_t* queue, staticQueueItem_t* item);
 
+/**
+ * Erase all items matching the predicate in a single pass. The remaining items keep their
+ * order. This is O(n), compared to erasing from a ForEach callback which is O(k*n).
+ * Reserved items that are not yet committed are never passed to the predicate.
+ * Input: Queue instance
+ * Input: Predicate, return true to erase the item
+ * Input: User context passed to the predicate
+ * Returns: Number of items erased, or negative error code
+ */
+int32_t staticQueueEraseIf(staticQueue_t* queue, staticQueuePredicate_t predicate, void* ctx);
+
+/**
+ * Defragment the queue in place so that the logical order, tail to head, matches the order of
+ * the backing array again. Middle erases splice nodes around in the ring, after many of them a
+ * traversal jumps randomly around memory. After compaction the front item is in the first array
+ * slot and each following item in the next slot, so traversals walk sequential memory.
+ * The payloads are moved with the swap callback, so pointers to items are invalidated.
+ * Fails with STATIC_QUEUE_INVALID if any item is reserved but not yet committed.
+ * Input: Queue instance
+ * Input: Callback that swaps the payload of two items
+ * Input: User context passed to the callback
+ * Returns: Number of payload swaps performed, or negative error code
+ */
+int32_t staticQueueCompact(staticQueue_t* queue, staticQueueSwapCb_t swap, void* ctx);
+
 /**
  * Check it the queue is full
  * Input: Queue instance
  * Returns: true if full
  */
-bool staticQueuefull(staticQueue_t* queue);
+STATIC_QUEUE_HOT bool staticQueuefull(staticQueue_t* queue);
 
 /**
  * Check it the queue is empty
  * Input: Queue instance
  * Returns: true if empty
  */
-bool staticQueueEmpty(staticQueue_t* queue);
+STATIC_QUEUE_HOT bool staticQueueEmpty(staticQueue_t* queue);
 
 /**
- * Get the number of active items in the queue
+ * Get the number of active items in the queue, including reserved items
  * Input: Queue instance
  * Returns: Number of items in queue, or negative error code
  */
 int32_t staticQueueGetNumItems(staticQueue_t* queue);
 
+/**
+ * Configure backpressure watermarks. The callback fires once when the number of items reaches
+ * the high watermark, and once when it has fallen back to the low watermark. Put/Pop/Erase only
+ * compare a counter, so there is no cost between the crossings.
+ * Input: Queue instance
+ * Input: High watermark, 0 disables the watermarks
+ * Input: Low watermark, must be lower than the high watermark
+ * Input: Callback, may be NULL if only staticQueueAboveWatermark is polled
+ * Input: User context passed to the callback
+ * Returns: queueErr_t
+ */
+int32_t staticQueueSetWatermarks(staticQueue_t*           queue,
+                                 uint32_t                 high,
+                                 uint32_t                 low,
+                                 staticQueueWatermarkCb_t callback,
+                                 void*                    ctx);
+
+/**
+ * Check if the queue has reached the high watermark and not yet fallen back to the low
+ * Input: Queue instance
+ * Returns: true if above the watermark
+ */
+bool staticQueueAboveWatermark(staticQueue_t* queue);
+
 /**
  * Loop through all items in queue and call the callback on each
  * Input: Queue instance
@@ -195,10 +587,144 @@ int32_t staticQueueGetNumItems(staticQueue_t* queue);
  */
 int32_t staticQueueForEach(staticQueue_t* queue, int32_t (*callback)(staticQueue_t *queue, staticQueueItem_t *item));
 
+/**
+ * Loop through all items in queue and call the callback on each, with a user context
+ * Input: Queue instance
+ * Input: Callback function
+ * Input: User context passed to the callback
+ * Returns: queueErr_t
+ */
+int32_t staticQueueForEachCtx(staticQueue_t* queue, staticQueueCallback_t callback, void* ctx);
+
+/**
+ * Find the first item, from the front of the queue, that matches the predicate
+ * Input: Queue instance
+ * Input: Predicate, return true on a match
+ * Input: User context passed to the predicate
+ * Input: This pointer will be populated with the matching item
+ * Returns: queueErr_t, STATIC_QUEUE_NOT_IN_QUEUE if there is no match, also in an empty queue
+ */
+int32_t staticQueueFind(staticQueue_t*         queue,
+                        staticQueuePredicate_t predicate,
+                        void*                  ctx,
+                        staticQueueItem_t**    found_item);
+
+#if STATIC_QUEUE_TRACE
+/**
+ * Start recording the operations on a queue. The queue must be empty and its ring in array
+ * order, as it is after init, so a replay can start from the same state. Recorded are Put,
+ * PutFirst, PutAfter, Pop, PopLast, Erase, MoveLast, Clear and ForEach with the erases and stop
+ * of its callback. The others, Reserve, Commit, evicting PutOverwrite, the value API, EraseIf and
+ * Compact, are only counted in unsupported, a trace with them will not replay.
+ * Input: Queue instance
+ * Input: Trace instance
+ * Input: Buffer for the records
+ * Input: Number of records in the buffer
+ * Returns: queueErr_t
+ */
+int32_t staticQueueTraceStart(staticQueue_t*      queue,
+                              staticQueueTrace_t* trace,
+                              uint32_t*           records,
+                              uint32_t            capacity);
+
+/**
+ * Stop recording, the trace keeps its records
+ * Input: Queue instance
+ * Returns: queueErr_t
+ */
+int32_t staticQueueTraceStop(staticQueue_t* queue);
+
+/**
+ * Add one record to the trace of the queue, used by the STATIC_QUEUE_TRACE_OP hooks
+ * Input: Queue instance
+ * Input: staticQueueTraceOp_t
+ * Input: Item the operation returned or took, may be NULL
+ */
+void staticQueueTraceRecord(staticQueue_t* queue, uint32_t op, staticQueueItem_t* item);
+
+#define STATIC_QUEUE_TRACE_OP(queue, op, item)                    \
+    do {                                                          \
+        if ((queue)->trace != NULL) {                             \
+            staticQueueTraceRecord((queue), (op), (item));        \
+        }                                                         \
+    } while (0)
+#else
+#define STATIC_QUEUE_TRACE_OP(queue, op, item) ((void)0)
+#endif
+
+#if STATIC_QUEUE_SEQLOCK
+/**
+ * Take a consistent snapshot of head, tail and the number of items. Safe to call from any
+ * thread while one writer changes the queue, the writer is never blocked. The reader retries
+ * only when a write overlaps, so it must not preempt the writer for good, e.g. from an
+ * interrupt or a higher priority task on the same core.
+ * Input: Queue instance
+ * Input: This pointer will be populated with the snapshot
+ * Returns: queueErr_t
+ */
+int32_t staticQueueSnapshot(staticQueue_t* queue, staticQueueSnapshot_t* snapshot);
+
+/**
+ * Copy out the payload of the front item, see staticQueueSetPayload, with the same guarantees
+ * as staticQueueSnapshot. The copy is only consistent if the writer fills payloads before they
+ * are visible, with Push or Reserve + Commit, and not after a Put.
+ * Input: Queue instance
+ * Input: Buffer the payload is copied to
+ * Returns: queueErr_t, STATIC_QUEUE_EMPTY if there is no visible front item
+ */
+int32_t staticQueuePeekCopy(staticQueue_t* queue, void* dst);
+#endif
+
+/**
+ * Re-execute a recorded trace against a queue. The queue must be freshly initialized, with the
+ * same length as the traced queue. Every item a Put or Pop returns, and every item ForEach
+ * visits, is checked against the record and passed to the visit callback, which can do the
+ * payload work of the real application.
+ * Input: Queue instance
+ * Input: Records, starting with the STATIC_QUEUE_TRACE_START record
+ * Input: Number of records
+ * Input: Callback for each item returned or visited, may be NULL. A negative return stops the replay
+ * Input: User context passed to the callback
+ * Returns: Number of records replayed, STATIC_QUEUE_INVALID if the queue does not behave as recorded
+ */
+int32_t staticQueueTraceReplay(staticQueue_t*        queue,
+                               const uint32_t*       records,
+                               uint32_t              num_records,
+                               staticQueueCallback_t visit,
+                               void*                 ctx);
+
 /**
  * This is a macro that makes it more safe to initialize a queue
  */
 #define STATIC_QUEUE_INIT(queue, list, size) \
     staticQueueInit((queue), (size), sizeof((list)[0]), &list->node)
 
+/**
+ * Set the value API payload to a member of the item struct, the member must be before the node
+ *     typedef struct {
+ *         myMsg_t           msg;
+ *         staticQueueItem_t node;
+ *     } myItem_t;
+ *     STATIC_QUEUE_SET_PAYLOAD(&my_queue, myItem_t, msg);
+ */
+#define STATIC_QUEUE_SET_PAYLOAD(queue, type, member) \
+    staticQueueSetPayload((queue), offsetof(type, node) - offsetof(type, member), sizeof(((type*)0)->member))
+
+/**
+ * Set the insertion timestamp to a uint64_t member of the item struct, the member must be before
+ * the node
+ *     typedef struct {
+ *         uint64_t          put_time;
+ *         uint32_t          my_data;
+ *         staticQueueItem_t node;
+ *     } myItem_t;
+ *     STATIC_QUEUE_SET_TIMESTAMP(&my_queue, myItem_t, put_time, myClock, NULL);
+ */
+#define STATIC_QUEUE_SET_TIMESTAMP(queue, type, member, clock, ctx) \
+    staticQueueSetTimestamp((queue), offsetof(type, node) - offsetof(type, member), (clock), (ctx))
+
+#ifdef STATIC_QUEUE_INLINE
+#include "static_queue_inline.h"
+#endif
+
 #endif /* INC_STATIC_QUEUE_H_ */
\ No newline at end of file
@@ -0,0 +1,189 @@
+/**
+ * @file:       static_queue_drr.c
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Implementation of deficit round robin scheduler over static queues
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "static_queue_drr.h"
+
+// Insert the flow last in the round, just before the flow being served
+static void activateFlow(staticQueueDrr_t* drr, staticQueueDrrFlow_t* flow)
+{
+    flow->active   = true;
+    flow->in_round = false;
+    flow->deficit  = 0;
+
+    if (drr->active == NULL) {
+        flow->next  = flow;
+        flow->last  = flow;
+        drr->active = flow;
+        return;
+    }
+
+    flow->next              = drr->active;
+    flow->last              = drr->active->last;
+    drr->active->last->next = flow;
+    drr->active->last       = flow;
+}
+
+static void deactivateFlow(staticQueueDrr_t* drr, staticQueueDrrFlow_t* flow)
+{
+    flow->active   = false;
+    flow->in_round = false;
+    // An empty flow does not keep its credit, as in standard DRR
+    flow->deficit  = 0;
+
+    if (flow->next == flow) {
+        drr->active = NULL;
+        return;
+    }
+
+    flow->last->next = flow->next;
+    flow->next->last = flow->last;
+    if (drr->active == flow) {
+        drr->active = flow->next;
+    }
+}
+
+int32_t staticQueueDrrInit(staticQueueDrr_t* drr,
+                           uint32_t (*cost)(staticQueueItem_t* item, void* ctx),
+                           void* cost_ctx)
+{
+    if (drr == NULL) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    drr->active   = NULL;
+    drr->cost     = cost;
+    drr->cost_ctx = cost_ctx;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticQueueDrrAddFlow(staticQueueDrr_t*     drr,
+                              staticQueueDrrFlow_t* flow,
+                              staticQueue_t*        queue,
+                              uint32_t              quantum)
+{
+    if (drr == NULL || flow == NULL || queue == NULL || quantum == 0) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    flow->queue   = queue;
+    flow->quantum = quantum;
+    flow->active  = false;
+
+    if (!staticQueueEmpty(queue)) {
+        activateFlow(drr, flow);
+    }
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticQueueDrrPut(staticQueueDrr_t* drr, staticQueueDrrFlow_t* flow, staticQueueItem_t** next_item)
+{
+    int32_t result = staticQueuePut(flow->queue, next_item);
+
+    if (result == STATIC_QUEUE_SUCCESS && !flow->active) {
+        activateFlow(drr, flow);
+    }
+
+    return result;
+}
+
+int32_t staticQueueDrrPop(staticQueueDrr_t* drr, staticQueueItem_t** pop_item, staticQueueDrrFlow_t** flow)
+{
+    staticQueueDrrFlow_t* first_blocked = NULL;
+
+    while (drr->active != NULL) {
+        staticQueueDrrFlow_t* current = drr->active;
+        staticQueueItem_t*    item;
+
+        if (staticQueuePeak(current->queue, &item) != STATIC_QUEUE_SUCCESS) {
+            if (staticQueueEmpty(current->queue)) {
+                deactivateFlow(drr, current);
+                continue;
+            }
+
+            // The front item is reserved but not committed, the flow stays active and is passed.
+            // Back at the first passed flow without a pop, every active flow is blocked.
+            if (current == first_blocked) {
+                return STATIC_QUEUE_EMPTY;
+            }
+            if (first_blocked == NULL) {
+                first_blocked = current;
+            }
+            drr->active = current->next;
+            continue;
+        }
+
+        if (!current->in_round) {
+            current->deficit += current->quantum;
+            current->in_round = true;
+        }
+
+        uint32_t cost = drr->cost != NULL ? drr->cost(item, drr->cost_ctx) : 1;
+        if (cost > current->deficit) {
+            // Out of credit for this round, the remaining deficit is carried to the next visit
+            current->in_round = false;
+            drr->active       = current->next;
+            // The deficit grows on every visit, so this flow pops eventually, start the count over
+            first_blocked     = NULL;
+            continue;
+        }
+
+        staticQueuePop(current->queue, pop_item);
+        current->deficit -= cost;
+
+        if (flow != NULL) {
+            *flow = current;
+        }
+
+        if (staticQueueEmpty(current->queue)) {
+            deactivateFlow(drr, current);
+        }
+
+        return STATIC_QUEUE_SUCCESS;
+    }
+
+    return STATIC_QUEUE_EMPTY;
+}
+
+int32_t staticQueueDrrErase(staticQueueDrr_t* drr, staticQueueDrrFlow_t* flow, staticQueueItem_t* item)
+{
+    int32_t result = staticQueueErase(flow->queue, item);
+
+    if (result == STATIC_QUEUE_SUCCESS && flow->active && staticQueueEmpty(flow->queue)) {
+        deactivateFlow(drr, flow);
+    }
+
+    return result;
+}
+
+bool staticQueueDrrEmpty(staticQueueDrr_t* drr)
+{
+    return drr->active == NULL;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file:       static_queue_drr.h
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Header file for deficit round robin scheduler over static queues
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#ifndef INC_STATIC_QUEUE_DRR_H_
+#define INC_STATIC_QUEUE_DRR_H_
+
+#include "static_queue.h"
+
+/**
+ * Deficit round robin scheduler over many static queues, one queue per flow (tenant). Only the
+ * flows that have items are kept in the active list, a flow is added on its empty to non-empty
+ * transition and removed when it runs empty, so empty flows are never visited.
+ *
+ * Each flow has a quantum, its weight, that is added to its deficit every round. An item is
+ * served when its cost fits in the deficit. With a cost callback the share is weighted by item
+ * cost, e.g. bytes, without it every item costs 1 and the scheduler is a weighted round robin.
+ *
+ *     staticQueueDrr_t     my_drr;
+ *     staticQueueDrrFlow_t my_flows[NUM_TENANTS];
+ *     staticQueueDrrInit(&my_drr, NULL, NULL);
+ *     for (i = 0; i < NUM_TENANTS; i++) {
+ *         staticQueueDrrAddFlow(&my_drr, &my_flows[i], &my_queues[i], weight[i]);
+ *     }
+ *
+ * All puts, pops and erases must go through the scheduler to keep the active list in sync.
+ */
+
+typedef struct staticQueueDrrFlow staticQueueDrrFlow_t;
+
+struct staticQueueDrrFlow {
+    staticQueue_t*        queue;
+    uint32_t              quantum;
+    uint32_t              deficit;
+    bool                  active;   // Flow is in the active list
+    bool                  in_round; // Quantum has been added for the current visit
+    staticQueueDrrFlow_t* next;
+    staticQueueDrrFlow_t* last;
+};
+
+typedef struct {
+    staticQueueDrrFlow_t* active; // The flow currently being served, NULL if all are empty
+    uint32_t (*cost)(staticQueueItem_t* item, void* ctx);
+    void*                 cost_ctx;
+} staticQueueDrr_t;
+
+/**
+ * Initialize a deficit round robin scheduler
+ * Input: Scheduler instance
+ * Input: Callback returning the cost of an item, NULL for a cost of 1 per item
+ * Input: User context passed to the cost callback
+ * Returns: queueErr_t
+ */
+int32_t staticQueueDrrInit(staticQueueDrr_t* drr,
+                           uint32_t (*cost)(staticQueueItem_t* item, void* ctx),
+                           void* cost_ctx);
+
+/**
+ * Add a flow to the scheduler, the queue must already be initialized and may contain items
+ * Input: Scheduler instance
+ * Input: Flow instance
+ * Input: Queue of the flow
+ * Input: Quantum added to the deficit of the flow each round, must be > 0
+ * Returns: queueErr_t
+ */
+int32_t staticQueueDrrAddFlow(staticQueueDrr_t*     drr,
+                              staticQueueDrrFlow_t* flow,
+                              staticQueue_t*        queue,
+                              uint32_t              quantum);
+
+/**
+ * Put an item at the end of a flow's queue
+ * Input: Scheduler instance
+ * Input: Flow instance
+ * Input: This pointer wil be populated with the pointer to the relevant item to write data to
+ * Returns: queueErr_t
+ */
+int32_t staticQueueDrrPut(staticQueueDrr_t* drr, staticQueueDrrFlow_t* flow, staticQueueItem_t** next_item);
+
+/**
+ * Get and remove the next item according to the deficit round robin order. The caller must
+ * have written the item data before it is put, as the cost callback reads it.
+ * Input: Scheduler instance
+ * Input: This pointer will be populated with the pop'ed item
+ * Input: This pointer will be populated with the flow of the item, may be NULL
+ * Returns: queueErr_t, STATIC_QUEUE_EMPTY also if every active flow has a reserved item in front
+ */
+int32_t staticQueueDrrPop(staticQueueDrr_t* drr, staticQueueItem_t** pop_item, staticQueueDrrFlow_t** flow);
+
+/**
+ * Erase a specific item from a flow's queue
+ * Input: Scheduler instance
+ * Input: Flow instance
+ * Input: Pointer to the item to erase
+ * Returns: queueErr_t
+ */
+int32_t staticQueueDrrErase(staticQueueDrr_t* drr, staticQueueDrrFlow_t* flow, staticQueueItem_t* item);
+
+/**
+ * Check if all flows are empty
+ * Input: Scheduler instance
+ * Returns: true if empty
+ */
+bool staticQueueDrrEmpty(staticQueueDrr_t* drr);
+
+#endif /* INC_STATIC_QUEUE_DRR_H_ */
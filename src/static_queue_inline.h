@@ -0,0 +1,200 @@
+/**
+ * @file:       static_queue_inline.h
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Hot path functions of the static queue module
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#ifndef INC_STATIC_QUEUE_INLINE_H_
+#define INC_STATIC_QUEUE_INLINE_H_
+
+#include "static_queue.h"
+
+/**
+ * The hot path functions of the static queue. Without STATIC_QUEUE_INLINE this file is only
+ * included by static_queue.c and STATIC_QUEUE_HOT is empty, so they are normal functions.
+ * With STATIC_QUEUE_INLINE static_queue.h includes it and they are static inline in every
+ * translation unit. Do not include it directly.
+ */
+
+static inline void staticQueuePrefetchItem(staticQueueItem_t* item)
+{
+#if STATIC_QUEUE_PREFETCH_DISTANCE > 0 && defined(__GNUC__)
+    __builtin_prefetch(item, 0, 3);
+    for (uint32_t i = 1; i <= STATIC_QUEUE_PREFETCH_PAYLOAD_LINES; i++) {
+        __builtin_prefetch((const char*)item - i * STATIC_QUEUE_CACHE_LINE_SIZE, 0, 3);
+    }
+#else
+    (void)item;
+#endif
+}
+
+// Start a lookahead pointer STATIC_QUEUE_PREFETCH_DISTANCE nodes in front of item
+static inline staticQueueItem_t* staticQueuePrefetchStart(staticQueueItem_t* item)
+{
+#if STATIC_QUEUE_PREFETCH_DISTANCE > 0
+    for (uint32_t i = 0; i < STATIC_QUEUE_PREFETCH_DISTANCE; i++) {
+        item = item->next;
+        staticQueuePrefetchItem(item);
+    }
+#endif
+    return item;
+}
+
+// Move the lookahead pointer one step, it always points to a node in the ring so it is safe to
+// follow even if the iteration erases nodes
+static inline staticQueueItem_t* staticQueuePrefetchStep(staticQueueItem_t* ahead)
+{
+#if STATIC_QUEUE_PREFETCH_DISTANCE > 0
+    ahead = ahead->next;
+    staticQueuePrefetchItem(ahead);
+#endif
+    return ahead;
+}
+
+// Stores to the fields that concurrent readers load, see staticQueueSnapshot. Relaxed atomic
+// stores are plain stores on the common targets, they only keep the compiler from tearing them.
+#define STATIC_QUEUE_STORE(field, value) __atomic_store_n(&(field), (value), __ATOMIC_RELAXED)
+
+// Track the number of items and note the watermark crossings, the callback fires in WriteEnd
+static inline void staticQueueCountUp(staticQueue_t* queue, uint32_t num)
+{
+    STATIC_QUEUE_STORE(queue->num_items, queue->num_items + num);
+    if (queue->high_watermark != 0 && !queue->above_watermark && queue->num_items >= queue->high_watermark) {
+        queue->above_watermark   = true;
+        queue->watermark_crossed = true;
+    }
+}
+
+static inline void staticQueueCountDown(staticQueue_t* queue, uint32_t num)
+{
+    STATIC_QUEUE_STORE(queue->num_items, queue->num_items - num);
+    if (queue->above_watermark && queue->num_items <= queue->low_watermark) {
+        queue->above_watermark   = false;
+        queue->watermark_crossed = true;
+    }
+}
+
+static inline uint64_t* staticQueueStampOf(staticQueue_t* queue, staticQueueItem_t* item)
+{
+    return (uint64_t*)((uint8_t*)item - queue->stamp_offset);
+}
+
+// Record the insertion time if the queue has a clock, see staticQueueSetTimestamp
+static inline void staticQueueStamp(staticQueue_t* queue, staticQueueItem_t* item)
+{
+    if (queue->clock != NULL) {
+        *staticQueueStampOf(queue, item) = queue->clock(queue->clock_ctx);
+    }
+}
+
+// Every change to the queue is wrapped in these. With STATIC_QUEUE_SEQLOCK they bump the version
+// counter for concurrent readers, odd while the writer changes the queue, see staticQueueSnapshot.
+static inline void staticQueueWriteBegin(staticQueue_t* queue)
+{
+#if STATIC_QUEUE_SEQLOCK
+    __atomic_store_n(&queue->version, queue->version + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+#else
+    (void)queue;
+#endif
+}
+
+// The watermark callback fires after the change is complete, so it may read or change the queue
+static inline void staticQueueWriteEnd(staticQueue_t* queue)
+{
+#if STATIC_QUEUE_SEQLOCK
+    __atomic_store_n(&queue->version, queue->version + 1, __ATOMIC_RELEASE);
+#endif
+
+    if (queue->watermark_crossed) {
+        queue->watermark_crossed = false;
+        if (queue->watermark_cb != NULL) {
+            queue->watermark_cb(queue, queue->above_watermark, queue->watermark_ctx);
+        }
+    }
+}
+
+STATIC_QUEUE_HOT bool staticQueuefull(staticQueue_t* queue)
+{
+    return (queue->head == queue->tail) && queue->head->active;
+}
+
+STATIC_QUEUE_HOT bool staticQueueEmpty(staticQueue_t* queue)
+{
+    return (queue->head == queue->tail) && !queue->head->active;
+}
+
+STATIC_QUEUE_HOT int32_t staticQueuePut(staticQueue_t* queue, staticQueueItem_t** next_item)
+{
+    if (staticQueuefull(queue)) {
+        return STATIC_QUEUE_FULL;
+    }
+
+    staticQueueWriteBegin(queue);
+    *next_item           = queue->head;
+    STATIC_QUEUE_STORE(queue->head->active, true);
+    STATIC_QUEUE_STORE(queue->head->pending, false);
+    staticQueueStamp(queue, queue->head);
+    STATIC_QUEUE_STORE(queue->head, queue->head->next);
+    staticQueueCountUp(queue, 1);
+    staticQueueWriteEnd(queue);
+    STATIC_QUEUE_TRACE_OP(queue, STATIC_QUEUE_TRACE_PUT, *next_item);
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+STATIC_QUEUE_HOT int32_t staticQueuePop(staticQueue_t* queue, staticQueueItem_t** pop_item)
+{
+    if (staticQueueEmpty(queue) || __atomic_load_n(&queue->tail->pending, __ATOMIC_ACQUIRE)) {
+        return STATIC_QUEUE_EMPTY;
+    }
+
+    staticQueueWriteBegin(queue);
+    *pop_item           = queue->tail;
+    STATIC_QUEUE_STORE(queue->tail->active, false);
+    STATIC_QUEUE_STORE(queue->tail, queue->tail->next);
+    staticQueueCountDown(queue, 1);
+    staticQueueWriteEnd(queue);
+    STATIC_QUEUE_TRACE_OP(queue, STATIC_QUEUE_TRACE_POP, *pop_item);
+
+    // Warm up the next item without following its links, a chase would wait on the misses
+    staticQueuePrefetchItem(queue->tail);
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+STATIC_QUEUE_HOT int32_t staticQueuePeak(staticQueue_t* queue, staticQueueItem_t** peak_item)
+{
+    if (staticQueueEmpty(queue) || __atomic_load_n(&queue->tail->pending, __ATOMIC_ACQUIRE)) {
+        return STATIC_QUEUE_EMPTY;
+    }
+
+    *peak_item = queue->tail;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+#endif /* INC_STATIC_QUEUE_INLINE_H_ */
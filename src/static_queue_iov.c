@@ -0,0 +1,223 @@
+/**
+ * @file:       static_queue_iov.c
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Implementation of static queue vectored I/O module
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "static_queue_iov.h"
+#include <limits.h>
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+static inline uint32_t capIov(uint32_t max_iov)
+{
+    return max_iov > IOV_MAX ? IOV_MAX : max_iov;
+}
+
+int32_t staticQueueIovWriterInit(staticQueueIovWriter_t* writer,
+                                 staticQueue_t*          queue,
+                                 staticQueueIovCb_t      iov_cb,
+                                 void*                   ctx)
+{
+    if (writer == NULL || queue == NULL || iov_cb == NULL) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    writer->queue  = queue;
+    writer->iov_cb = iov_cb;
+    writer->ctx    = ctx;
+    writer->offset = 0;
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticQueueIovGather(staticQueueIovWriter_t* writer, struct iovec* iov, uint32_t max_iov)
+{
+    staticQueue_t*     queue = writer->queue;
+    staticQueueItem_t* item  = queue->tail;
+    uint32_t           count = (uint32_t)staticQueueGetNumItems(queue);
+    uint32_t           num   = 0;
+
+    max_iov = capIov(max_iov);
+    if (count > max_iov) {
+        count = max_iov;
+    }
+
+    // Stop at the first reserved item, like Pop does
+    while (num < count && !__atomic_load_n(&item->pending, __ATOMIC_ACQUIRE)) {
+        writer->iov_cb(queue, item, &iov[num], writer->ctx);
+        item = item->next;
+        num++;
+    }
+
+    if (num == 0) {
+        return STATIC_QUEUE_EMPTY;
+    }
+
+    // Skip what an earlier partial write already sent
+    iov[0].iov_base = (uint8_t*)iov[0].iov_base + writer->offset;
+    iov[0].iov_len -= writer->offset;
+
+    return num;
+}
+
+int32_t staticQueueIovConsume(staticQueueIovWriter_t* writer,
+                              const struct iovec*     iov,
+                              uint32_t                num_iov,
+                              size_t                  written)
+{
+    staticQueueItem_t* item;
+    uint32_t           popped = 0;
+
+    while (popped < num_iov && written >= iov[popped].iov_len) {
+        written -= iov[popped].iov_len;
+        staticQueuePop(writer->queue, &item);
+        writer->offset = 0;
+        popped++;
+    }
+
+    // The first item left was partially written
+    if (popped < num_iov) {
+        writer->offset += written;
+    }
+
+    return popped;
+}
+
+int32_t staticQueueWritev(staticQueueIovWriter_t* writer,
+                          int                     fd,
+                          struct iovec*           iov,
+                          uint32_t                max_iov,
+                          size_t*                 written)
+{
+    if (written != NULL) {
+        *written = 0;
+    }
+
+    int32_t num_iov = staticQueueIovGather(writer, iov, max_iov);
+    if (num_iov < 0) {
+        return num_iov;
+    }
+
+    ssize_t result = writev(fd, iov, num_iov);
+    if (result < 0) {
+        return STATIC_QUEUE_IO_ERROR;
+    }
+
+    staticQueueIovConsume(writer, iov, num_iov, (size_t)result);
+    if (written != NULL) {
+        *written = (size_t)result;
+    }
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticQueueIovScatter(staticQueue_t*     queue,
+                              struct iovec*      iov,
+                              uint32_t           max_iov,
+                              staticQueueIovCb_t iov_cb,
+                              void*              ctx)
+{
+    // The free items start at head and are put in ring order, so Put hands them out in this order
+    staticQueueItem_t* item  = queue->head;
+    uint32_t           count = queue->queue_length - (uint32_t)staticQueueGetNumItems(queue);
+    uint32_t           num   = 0;
+
+    max_iov = capIov(max_iov);
+    if (count > max_iov) {
+        count = max_iov;
+    }
+
+    while (num < count) {
+        iov_cb(queue, item, &iov[num], ctx);
+        item = item->next;
+        num++;
+    }
+
+    if (num == 0) {
+        return STATIC_QUEUE_FULL;
+    }
+
+    return num;
+}
+
+int32_t staticQueueIovFill(staticQueue_t*         queue,
+                           const struct iovec*    iov,
+                           uint32_t               num_iov,
+                           size_t                 num_read,
+                           staticQueueIovDoneCb_t done_cb,
+                           void*                  ctx)
+{
+    staticQueueItem_t* item;
+    uint32_t           put = 0;
+
+    while (put < num_iov && num_read > 0) {
+        size_t len = num_read < iov[put].iov_len ? num_read : iov[put].iov_len;
+        num_read -= len;
+
+        // Set the length before the item is put, so it is complete once it is visible
+        if (done_cb != NULL) {
+            done_cb(queue, queue->head, len, ctx);
+        }
+        staticQueuePut(queue, &item);
+        put++;
+    }
+
+    return put;
+}
+
+int32_t staticQueueReadv(staticQueue_t*         queue,
+                         int                    fd,
+                         struct iovec*          iov,
+                         uint32_t               max_iov,
+                         staticQueueIovCb_t     iov_cb,
+                         staticQueueIovDoneCb_t done_cb,
+                         void*                  ctx,
+                         size_t*                num_read)
+{
+    if (num_read != NULL) {
+        *num_read = 0;
+    }
+
+    int32_t num_iov = staticQueueIovScatter(queue, iov, max_iov, iov_cb, ctx);
+    if (num_iov < 0) {
+        return num_iov;
+    }
+
+    ssize_t result = readv(fd, iov, num_iov);
+    if (result < 0) {
+        return STATIC_QUEUE_IO_ERROR;
+    }
+
+    staticQueueIovFill(queue, iov, num_iov, (size_t)result, done_cb, ctx);
+    if (num_read != NULL) {
+        *num_read = (size_t)result;
+    }
+
+    return STATIC_QUEUE_SUCCESS;
+}
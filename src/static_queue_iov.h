@@ -0,0 +1,172 @@
+/**
+ * @file:       static_queue_iov.h
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Header file for static queue vectored I/O module
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#ifndef INC_STATIC_QUEUE_IOV_H_
+#define INC_STATIC_QUEUE_IOV_H_
+
+#include "static_queue.h"
+#include <sys/uio.h>
+
+/**
+ * Moves queued items to and from file descriptors with one writev/readv per batch instead of one
+ * system call per item. An iov callback describes the bytes of an item: its data when writing,
+ * or its free buffer when reading.
+ *
+ * Writing: staticQueueWritev gathers up to max_iov items into iovecs and pops only the items the
+ * kernel fully accepted. After a partial write the writer remembers how much of the first item
+ * was sent and the next call continues from there. To use sendmsg or another call, use
+ * staticQueueIovGather and staticQueueIovConsume around it.
+ *
+ * Reading: staticQueueReadv scatters into the buffers of the free items and puts every item that
+ * received data, the done callback gets the number of bytes in each of them before it is put.
+ *
+ * The number of iovecs per call is capped at IOV_MAX.
+ */
+
+/**
+ * Describe the bytes of an item, set iov_base and iov_len
+ */
+typedef void (*staticQueueIovCb_t)(staticQueue_t* queue, staticQueueItem_t* item, struct iovec* iov, void* ctx);
+
+/**
+ * Called with the number of bytes read into an item, before the item is put
+ */
+typedef void (*staticQueueIovDoneCb_t)(staticQueue_t* queue, staticQueueItem_t* item, size_t len, void* ctx);
+
+typedef struct {
+    staticQueue_t*     queue;
+    staticQueueIovCb_t iov_cb;
+    void*              ctx;
+    size_t             offset; // Bytes of the first item that are already written
+} staticQueueIovWriter_t;
+
+/**
+ * Initialize a writer for a queue
+ * Input: Writer instance
+ * Input: Queue to write items from
+ * Input: Callback that describes the data of an item
+ * Input: User context passed to the callback
+ * Returns: queueErr_t
+ */
+int32_t staticQueueIovWriterInit(staticQueueIovWriter_t* writer,
+                                 staticQueue_t*          queue,
+                                 staticQueueIovCb_t      iov_cb,
+                                 void*                   ctx);
+
+/**
+ * Describe the first queued items as iovecs, nothing is pop'ed
+ * Input: Writer instance
+ * Input: Array that will be populated with the iovecs
+ * Input: Size of the iovec array
+ * Returns: Number of iovecs, or STATIC_QUEUE_EMPTY
+ */
+int32_t staticQueueIovGather(staticQueueIovWriter_t* writer, struct iovec* iov, uint32_t max_iov);
+
+/**
+ * Pop the items that a write of gathered iovecs fully sent, and remember the partial item
+ * Input: Writer instance
+ * Input: The iovecs from staticQueueIovGather
+ * Input: Number of iovecs
+ * Input: Number of bytes the write accepted
+ * Returns: Number of items pop'ed
+ */
+int32_t staticQueueIovConsume(staticQueueIovWriter_t* writer,
+                              const struct iovec*     iov,
+                              uint32_t                num_iov,
+                              size_t                  written);
+
+/**
+ * Write queued items to a file descriptor with one writev
+ * Input: Writer instance
+ * Input: File descriptor
+ * Input: Scratch iovec array
+ * Input: Size of the iovec array
+ * Input: This will be populated with the number of bytes written, may be NULL
+ * Returns: queueErr_t, STATIC_QUEUE_IO_ERROR with errno set if writev failed
+ */
+int32_t staticQueueWritev(staticQueueIovWriter_t* writer,
+                          int                     fd,
+                          struct iovec*           iov,
+                          uint32_t                max_iov,
+                          size_t*                 written);
+
+/**
+ * Describe the buffers of the free items as iovecs, nothing is put
+ * Input: Queue instance
+ * Input: Array that will be populated with the iovecs
+ * Input: Size of the iovec array
+ * Input: Callback that describes the buffer of an item
+ * Input: User context passed to the callback
+ * Returns: Number of iovecs, or STATIC_QUEUE_FULL
+ */
+int32_t staticQueueIovScatter(staticQueue_t*     queue,
+                              struct iovec*      iov,
+                              uint32_t           max_iov,
+                              staticQueueIovCb_t iov_cb,
+                              void*              ctx);
+
+/**
+ * Put the items that a read into scattered iovecs filled, the last one may be partially filled
+ * Input: Queue instance
+ * Input: The iovecs from staticQueueIovScatter
+ * Input: Number of iovecs
+ * Input: Number of bytes read
+ * Input: Callback that gets the number of bytes in each item, may be NULL
+ * Input: User context passed to the callback
+ * Returns: Number of items put
+ */
+int32_t staticQueueIovFill(staticQueue_t*         queue,
+                           const struct iovec*    iov,
+                           uint32_t               num_iov,
+                           size_t                 num_read,
+                           staticQueueIovDoneCb_t done_cb,
+                           void*                  ctx);
+
+/**
+ * Read from a file descriptor into free items with one readv
+ * Input: Queue instance
+ * Input: File descriptor
+ * Input: Scratch iovec array
+ * Input: Size of the iovec array
+ * Input: Callback that describes the buffer of an item
+ * Input: Callback that gets the number of bytes in each item, may be NULL
+ * Input: User context passed to the callbacks
+ * Input: This will be populated with the number of bytes read, 0 at end of file, may be NULL
+ * Returns: queueErr_t, STATIC_QUEUE_IO_ERROR with errno set if readv failed
+ */
+int32_t staticQueueReadv(staticQueue_t*         queue,
+                         int                    fd,
+                         struct iovec*          iov,
+                         uint32_t               max_iov,
+                         staticQueueIovCb_t     iov_cb,
+                         staticQueueIovDoneCb_t done_cb,
+                         void*                  ctx,
+                         size_t*                num_read);
+
+#endif /* INC_STATIC_QUEUE_IOV_H_ */
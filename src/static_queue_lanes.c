@@ -0,0 +1,162 @@
+/**
+ * @file:       static_queue_lanes.c
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Implementation of static queue priority lanes module
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "static_queue_lanes.h"
+
+#define LANE_BIT(lane) (0x80000000u >> (lane))
+
+static inline uint32_t countLeadingZeros(uint32_t value)
+{
+#if defined(__GNUC__)
+    return __builtin_clz(value);
+#else
+    uint32_t count = 0;
+    while (!(value & 0x80000000u)) {
+        value <<= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+// Keep the bitmap in sync with a lane after it has been modified
+static inline void updateLane(staticQueueLanes_t* lanes, uint32_t lane)
+{
+    if (staticQueueEmpty(&lanes->queues[lane])) {
+        lanes->non_empty &= ~LANE_BIT(lane);
+    } else {
+        lanes->non_empty |= LANE_BIT(lane);
+    }
+}
+
+int32_t staticQueueLanesInit(staticQueueLanes_t* lanes, staticQueue_t* queues, uint32_t num_lanes)
+{
+    if (lanes == NULL || queues == NULL || num_lanes == 0 || num_lanes > STATIC_QUEUE_LANES_MAX) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    lanes->queues    = queues;
+    lanes->num_lanes = num_lanes;
+    lanes->non_empty = 0;
+
+    for (uint32_t lane = 0; lane < num_lanes; lane++) {
+        updateLane(lanes, lane);
+    }
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+int32_t staticQueueLanesPut(staticQueueLanes_t* lanes, uint32_t lane, staticQueueItem_t** next_item)
+{
+    if (lane >= lanes->num_lanes) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    int32_t result = staticQueuePut(&lanes->queues[lane], next_item);
+    if (result == STATIC_QUEUE_SUCCESS) {
+        lanes->non_empty |= LANE_BIT(lane);
+    }
+
+    return result;
+}
+
+int32_t staticQueueLanesPutFirst(staticQueueLanes_t* lanes, uint32_t lane, staticQueueItem_t** next_item)
+{
+    if (lane >= lanes->num_lanes) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    int32_t result = staticQueuePutFirst(&lanes->queues[lane], next_item);
+    if (result == STATIC_QUEUE_SUCCESS) {
+        lanes->non_empty |= LANE_BIT(lane);
+    }
+
+    return result;
+}
+
+int32_t staticQueueLanesNext(staticQueueLanes_t* lanes)
+{
+    if (lanes->non_empty == 0) {
+        return STATIC_QUEUE_EMPTY;
+    }
+
+    return countLeadingZeros(lanes->non_empty);
+}
+
+int32_t staticQueueLanesPop(staticQueueLanes_t* lanes, staticQueueItem_t** pop_item, uint32_t* lane)
+{
+    int32_t next = staticQueueLanesNext(lanes);
+    if (next < 0) {
+        return next;
+    }
+
+    int32_t result = staticQueuePop(&lanes->queues[next], pop_item);
+    if (result == STATIC_QUEUE_SUCCESS) {
+        updateLane(lanes, next);
+        if (lane != NULL) {
+            *lane = next;
+        }
+    }
+
+    return result;
+}
+
+int32_t staticQueueLanesPeak(staticQueueLanes_t* lanes, staticQueueItem_t** peak_item, uint32_t* lane)
+{
+    int32_t next = staticQueueLanesNext(lanes);
+    if (next < 0) {
+        return next;
+    }
+
+    int32_t result = staticQueuePeak(&lanes->queues[next], peak_item);
+    if (result == STATIC_QUEUE_SUCCESS && lane != NULL) {
+        *lane = next;
+    }
+
+    return result;
+}
+
+int32_t staticQueueLanesErase(staticQueueLanes_t* lanes, uint32_t lane, staticQueueItem_t* item)
+{
+    if (lane >= lanes->num_lanes) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    int32_t result = staticQueueErase(&lanes->queues[lane], item);
+    if (result == STATIC_QUEUE_SUCCESS) {
+        updateLane(lanes, lane);
+    }
+
+    return result;
+}
+
+bool staticQueueLanesEmpty(staticQueueLanes_t* lanes)
+{
+    return lanes->non_empty == 0;
+}
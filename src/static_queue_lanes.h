@@ -0,0 +1,126 @@
+/**
+ * @file:       static_queue_lanes.h
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Header file for static queue priority lanes module
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#ifndef INC_STATIC_QUEUE_LANES_H_
+#define INC_STATIC_QUEUE_LANES_H_
+
+#include "static_queue.h"
+
+/**
+ * A set of static queues used as priority lanes. Lane 0 has the highest priority. The lane set
+ * keeps a bitmap of the non-empty lanes, so finding the next lane to serve is a single count
+ * leading zeros, regardless of the number of lanes.
+ *
+ * Init each lane as a normal static queue, then init the lane set with the array of queues
+ *     staticQueue_t      my_queues[NUM_LANES];
+ *     staticQueueLanes_t my_lanes;
+ *     STATIC_QUEUE_INIT(&my_queues[0], my_lane0_array, LANE0_SIZE);
+ *     ...
+ *     staticQueueLanesInit(&my_lanes, my_queues, NUM_LANES);
+ *
+ * All puts, pops and erases must go through the lane set to keep the bitmap in sync.
+ */
+
+#define STATIC_QUEUE_LANES_MAX 32
+
+typedef struct {
+    staticQueue_t* queues;
+    uint32_t       num_lanes;
+    uint32_t       non_empty; // Bit (31 - lane) is set if the lane has items
+} staticQueueLanes_t;
+
+/**
+ * Initialize a lane set, the queues must already be initialized and may contain items
+ * Input: Lane set instance
+ * Input: Array of queues, index is the lane priority, 0 is the highest
+ * Input: Number of lanes, max STATIC_QUEUE_LANES_MAX
+ * Returns: queueErr_t
+ */
+int32_t staticQueueLanesInit(staticQueueLanes_t* lanes, staticQueue_t* queues, uint32_t num_lanes);
+
+/**
+ * Put an item at the end of a lane
+ * Input: Lane set instance
+ * Input: Lane to put the item in
+ * Input: This pointer wil be populated with the pointer to the relevant item to write data to
+ * Returns: queueErr_t
+ */
+int32_t staticQueueLanesPut(staticQueueLanes_t* lanes, uint32_t lane, staticQueueItem_t** next_item);
+
+/**
+ * Put an item at the start of a lane, it will be the next pop'ed from that lane
+ * Input: Lane set instance
+ * Input: Lane to put the item in
+ * Input: This pointer wil be populated with the pointer to the relevant item to write data to
+ * Returns: queueErr_t
+ */
+int32_t staticQueueLanesPutFirst(staticQueueLanes_t* lanes, uint32_t lane, staticQueueItem_t** next_item);
+
+/**
+ * Get and remove the next item from the highest priority non-empty lane
+ * Input: Lane set instance
+ * Input: This pointer will be populated with the pop'ed item
+ * Input: This pointer will be populated with the lane of the item, may be NULL
+ * Returns: queueErr_t
+ */
+int32_t staticQueueLanesPop(staticQueueLanes_t* lanes, staticQueueItem_t** pop_item, uint32_t* lane);
+
+/**
+ * Get the next item from the highest priority non-empty lane, but do not remove it
+ * Input: Lane set instance
+ * Input: This pointer will be populated with the item
+ * Input: This pointer will be populated with the lane of the item, may be NULL
+ * Returns: queueErr_t
+ */
+int32_t staticQueueLanesPeak(staticQueueLanes_t* lanes, staticQueueItem_t** peak_item, uint32_t* lane);
+
+/**
+ * Erase a specific item from a lane
+ * Input: Lane set instance
+ * Input: Lane the item is in
+ * Input: Pointer to the item to erase
+ * Returns: queueErr_t
+ */
+int32_t staticQueueLanesErase(staticQueueLanes_t* lanes, uint32_t lane, staticQueueItem_t* item);
+
+/**
+ * Get the highest priority lane that has items
+ * Input: Lane set instance
+ * Returns: Lane index, or STATIC_QUEUE_EMPTY if all lanes are empty
+ */
+int32_t staticQueueLanesNext(staticQueueLanes_t* lanes);
+
+/**
+ * Check if all lanes are empty
+ * Input: Lane set instance
+ * Returns: true if empty
+ */
+bool staticQueueLanesEmpty(staticQueueLanes_t* lanes);
+
+#endif /* INC_STATIC_QUEUE_LANES_H_ */
@@ -0,0 +1,142 @@
+/**
+ * @file:       static_queue_typed.h
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Generator for type specialized static queues
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#ifndef INC_STATIC_QUEUE_TYPED_H_
+#define INC_STATIC_QUEUE_TYPED_H_
+
+#include "static_queue.h"
+
+/**
+ * STATIC_QUEUE_DEFINE(name, type, N) generates a FIFO queue of N items of the given type with
+ * static inline functions. The item type needs no staticQueueItem_t, the functions hand out
+ * typed pointers into the array, and N is a compile time constant so the index arithmetic folds
+ * into a mask when N is a power of two. Other sizes wrap the positions at 2 * N instead.
+ *
+ *     STATIC_QUEUE_DEFINE(msgQueue, myMsg_t, 64);
+ *
+ *     msgQueue_t my_queue;
+ *     myMsg_t*   msg;
+ *     msgQueueInit(&my_queue);
+ *     if (msgQueuePut(&my_queue, &msg) == STATIC_QUEUE_SUCCESS) {
+ *         msg->value = 1;
+ *     }
+ *
+ * Generated: name_t, nameInit, namePut, namePop, namePeak, nameClear, namefull, nameEmpty and
+ * nameGetNumItems, with the same semantics as the generic functions. A pop'ed item stays valid
+ * until the next put.
+ */
+
+#define STATIC_QUEUE_IS_POW2(n) (((n) & ((n) - 1)) == 0)
+
+#define STATIC_QUEUE_DEFINE(name, type, N)                                                        \
+    typedef struct {                                                                              \
+        type     items[(N)];                                                                      \
+        uint32_t head; /* Position of the next put */                                            \
+        uint32_t tail; /* Position of the next pop */                                            \
+    } name##_t;                                                                                   \
+                                                                                                  \
+    /* Power of two sizes use free running positions, others wrap them at 2 * N */               \
+    static inline uint32_t name##Index(uint32_t position)                                         \
+    {                                                                                             \
+        if (STATIC_QUEUE_IS_POW2(N)) {                                                            \
+            return position & ((N) - 1);                                                          \
+        }                                                                                         \
+        return position >= (N) ? position - (N) : position;                                       \
+    }                                                                                             \
+                                                                                                  \
+    static inline uint32_t name##Advance(uint32_t position)                                       \
+    {                                                                                             \
+        if (STATIC_QUEUE_IS_POW2(N)) {                                                            \
+            return position + 1;                                                                  \
+        }                                                                                         \
+        return position + 1 == 2 * (N) ? 0 : position + 1;                                        \
+    }                                                                                             \
+                                                                                                  \
+    static inline void name##Init(name##_t* queue)                                                \
+    {                                                                                             \
+        queue->head = 0;                                                                          \
+        queue->tail = 0;                                                                          \
+    }                                                                                             \
+                                                                                                  \
+    static inline void name##Clear(name##_t* queue)                                               \
+    {                                                                                             \
+        queue->tail = queue->head;                                                                \
+    }                                                                                             \
+                                                                                                  \
+    static inline uint32_t name##GetNumItems(const name##_t* queue)                               \
+    {                                                                                             \
+        if (STATIC_QUEUE_IS_POW2(N) || queue->head >= queue->tail) {                              \
+            return queue->head - queue->tail;                                                     \
+        }                                                                                         \
+        return queue->head + 2 * (N) - queue->tail;                                               \
+    }                                                                                             \
+                                                                                                  \
+    static inline bool name##Empty(const name##_t* queue)                                         \
+    {                                                                                             \
+        return queue->head == queue->tail;                                                        \
+    }                                                                                             \
+                                                                                                  \
+    static inline bool name##full(const name##_t* queue)                                          \
+    {                                                                                             \
+        return name##GetNumItems(queue) == (N);                                                   \
+    }                                                                                             \
+                                                                                                  \
+    static inline int32_t name##Put(name##_t* queue, type** next_item)                            \
+    {                                                                                             \
+        if (name##full(queue)) {                                                                  \
+            return STATIC_QUEUE_FULL;                                                             \
+        }                                                                                         \
+        *next_item  = &queue->items[name##Index(queue->head)];                                    \
+        queue->head = name##Advance(queue->head);                                                 \
+        return STATIC_QUEUE_SUCCESS;                                                              \
+    }                                                                                             \
+                                                                                                  \
+    static inline int32_t name##Peak(name##_t* queue, type** peak_item)                           \
+    {                                                                                             \
+        if (name##Empty(queue)) {                                                                 \
+            return STATIC_QUEUE_EMPTY;                                                            \
+        }                                                                                         \
+        *peak_item = &queue->items[name##Index(queue->tail)];                                     \
+        return STATIC_QUEUE_SUCCESS;                                                              \
+    }                                                                                             \
+                                                                                                  \
+    static inline int32_t name##Pop(name##_t* queue, type** pop_item)                             \
+    {                                                                                             \
+        if (name##Empty(queue)) {                                                                 \
+            return STATIC_QUEUE_EMPTY;                                                            \
+        }                                                                                         \
+        *pop_item   = &queue->items[name##Index(queue->tail)];                                    \
+        queue->tail = name##Advance(queue->tail);                                                 \
+        return STATIC_QUEUE_SUCCESS;                                                              \
+    }                                                                                             \
+                                                                                                  \
+    /* Redeclaration so the macro can be used with a trailing semicolon */                        \
+    static inline void name##Init(name##_t* queue)
+
+#endif /* INC_STATIC_QUEUE_TYPED_H_ */
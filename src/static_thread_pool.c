@@ -0,0 +1,350 @@
+/**
+ * @file:       static_thread_pool.c
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Implementation of static thread pool module
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include "static_thread_pool.h"
+#include <sched.h>
+#include <string.h>
+
+// Scans for work an idle worker makes, yielding in between, before it goes to sleep
+#define IDLE_ROUNDS 16
+
+// Round robin start of the single submissions from this thread, per thread so submitters do not
+// share a counter
+static _Thread_local uint32_t t_next_shard = 0;
+
+// Take one task from a shard, the record is copied out as the slot is free after the pop
+static bool takeTask(staticThreadPoolWorker_t* worker, staticPoolTask_t* task)
+{
+    staticQueueItem_t* item;
+
+    if (staticQueuePop(&worker->queue, &item) != STATIC_QUEUE_SUCCESS) {
+        return false;
+    }
+
+    staticPoolTask_t* queued = CONTAINER_OF(item, staticPoolTask_t, node);
+    task->fn                 = queued->fn;
+    task->arg                = queued->arg;
+    return true;
+}
+
+static bool stealTask(staticThreadPoolWorker_t* worker, staticPoolTask_t* task)
+{
+    staticThreadPool_t* pool  = worker->pool;
+    uint32_t            index = (uint32_t)(worker - pool->workers);
+
+    for (uint32_t i = 1; i < pool->num_workers; i++) {
+        staticThreadPoolWorker_t* victim = &pool->workers[(index + i) % pool->num_workers];
+        // The count is stored atomically, an empty shard is passed without taking its lock
+        if (__atomic_load_n(&victim->queue.num_items, __ATOMIC_RELAXED) == 0) {
+            continue;
+        }
+        pthread_mutex_lock(&victim->mutex);
+        bool found = takeTask(victim, task);
+        pthread_mutex_unlock(&victim->mutex);
+        if (found) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void runTask(staticThreadPool_t* pool, staticPoolTask_t* task)
+{
+    task->fn(task->arg);
+
+    if (__atomic_sub_fetch(&pool->pending, 1, __ATOMIC_ACQ_REL) == 0) {
+        pthread_mutex_lock(&pool->idle_mutex);
+        pthread_cond_broadcast(&pool->idle_cond);
+        pthread_mutex_unlock(&pool->idle_mutex);
+    }
+}
+
+static void* workerThread(void* arg)
+{
+    staticThreadPoolWorker_t* worker = arg;
+    staticThreadPool_t*       pool   = worker->pool;
+    staticPoolTask_t          task;
+    uint32_t                  idle_rounds = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&worker->mutex);
+        bool found = takeTask(worker, &task);
+        pthread_mutex_unlock(&worker->mutex);
+
+        if (found || stealTask(worker, &task)) {
+            runTask(pool, &task);
+            idle_rounds = 0;
+            continue;
+        }
+
+        // Give the submitters a few chances before paying for a sleep and a wakeup
+        if (idle_rounds < IDLE_ROUNDS) {
+            idle_rounds++;
+            sched_yield();
+            continue;
+        }
+        idle_rounds = 0;
+
+        // Nothing anywhere, sleep until something is put in this shard or another shard has work
+        // for it to take, see wakeSleeper. Any wakeup goes back to the scan above.
+        pthread_mutex_lock(&worker->mutex);
+        if (staticQueueEmpty(&worker->queue) && !__atomic_load_n(&pool->stop, __ATOMIC_ACQUIRE)) {
+            __atomic_store_n(&worker->sleeping, true, __ATOMIC_RELAXED);
+            pthread_cond_wait(&worker->cond, &worker->mutex);
+            __atomic_store_n(&worker->sleeping, false, __ATOMIC_RELAXED);
+        }
+        bool stop = staticQueueEmpty(&worker->queue) && __atomic_load_n(&pool->stop, __ATOMIC_ACQUIRE);
+        pthread_mutex_unlock(&worker->mutex);
+
+        if (stop) {
+            return NULL;
+        }
+    }
+}
+
+// Destroy the mutexes and condition variables of the workers in [first, last)
+static void destroyWorkers(staticThreadPoolWorker_t* workers, uint32_t first, uint32_t last)
+{
+    for (uint32_t i = first; i < last; i++) {
+        pthread_mutex_destroy(&workers[i].mutex);
+        pthread_cond_destroy(&workers[i].cond);
+    }
+}
+
+int32_t staticThreadPoolInit(staticThreadPool_t*       pool,
+                             staticThreadPoolWorker_t* workers,
+                             uint32_t                  num_workers,
+                             staticPoolTask_t*         tasks,
+                             uint32_t                  tasks_per_worker)
+{
+    if (pool == NULL || workers == NULL || tasks == NULL || num_workers == 0 || tasks_per_worker == 0) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    pool->workers     = workers;
+    pool->num_workers = num_workers;
+    pool->next_shard  = 0;
+    pool->pending     = 0;
+    pool->stop        = false;
+    if (pthread_mutex_init(&pool->idle_mutex, NULL) != 0) {
+        return STATIC_QUEUE_IO_ERROR;
+    }
+    if (pthread_cond_init(&pool->idle_cond, NULL) != 0) {
+        pthread_mutex_destroy(&pool->idle_mutex);
+        return STATIC_QUEUE_IO_ERROR;
+    }
+
+    // The queues need inactive items, the records are internal so clear them here
+    memset(tasks, 0, sizeof(tasks[0]) * num_workers * tasks_per_worker);
+
+    for (uint32_t i = 0; i < num_workers; i++) {
+        staticThreadPoolWorker_t* worker = &workers[i];
+        staticPoolTask_t*         shard  = &tasks[i * tasks_per_worker];
+        STATIC_QUEUE_INIT(&worker->queue, shard, tasks_per_worker);
+        worker->pool     = pool;
+        worker->sleeping = false;
+
+        bool mutex_ok = pthread_mutex_init(&worker->mutex, NULL) == 0;
+        if (!mutex_ok || pthread_cond_init(&worker->cond, NULL) != 0) {
+            if (mutex_ok) {
+                pthread_mutex_destroy(&worker->mutex);
+            }
+            destroyWorkers(workers, 0, i);
+            pthread_mutex_destroy(&pool->idle_mutex);
+            pthread_cond_destroy(&pool->idle_cond);
+            return STATIC_QUEUE_IO_ERROR;
+        }
+    }
+
+    for (uint32_t i = 0; i < num_workers; i++) {
+        if (pthread_create(&workers[i].thread, NULL, workerThread, &workers[i]) != 0) {
+            // Destroy stops and cleans up the running workers, the rest never ran
+            destroyWorkers(workers, i, num_workers);
+            pool->num_workers = i;
+            staticThreadPoolDestroy(pool);
+            return STATIC_QUEUE_IO_ERROR;
+        }
+    }
+
+    return STATIC_QUEUE_SUCCESS;
+}
+
+// The first sleeping worker from start on, the flags are read without the locks so it is a hint
+static staticThreadPoolWorker_t* findSleeper(staticThreadPool_t* pool, uint32_t start)
+{
+    for (uint32_t i = 0; i < pool->num_workers; i++) {
+        staticThreadPoolWorker_t* worker = &pool->workers[(start + i) % pool->num_workers];
+        if (__atomic_load_n(&worker->sleeping, __ATOMIC_RELAXED)) {
+            return worker;
+        }
+    }
+
+    return NULL;
+}
+
+// Wake a worker under its own lock. The flag is cleared here so the next submission picks
+// another sleeper instead of this one before it has run.
+static bool wakeWorker(staticThreadPoolWorker_t* worker)
+{
+    bool woken = false;
+
+    pthread_mutex_lock(&worker->mutex);
+    if (worker->sleeping) {
+        __atomic_store_n(&worker->sleeping, false, __ATOMIC_RELAXED);
+        pthread_cond_signal(&worker->cond);
+        woken = true;
+    }
+    pthread_mutex_unlock(&worker->mutex);
+
+    return woken;
+}
+
+// A sleeping worker only watches its own shard, wake one to take work from a busy shard
+static void wakeSleeper(staticThreadPool_t* pool, uint32_t start)
+{
+    staticThreadPoolWorker_t* sleeper;
+
+    while ((sleeper = findSleeper(pool, start)) != NULL) {
+        if (wakeWorker(sleeper)) {
+            return;
+        }
+    }
+}
+
+// Put up to num_tasks tasks in one shard, the caller holds no lock. The tasks are counted as
+// pending before the lock is released, so WaitAll never sees a false zero.
+static uint32_t submitShard(staticThreadPoolWorker_t* worker, staticPoolTaskFn_t fn, void** args, uint32_t num_tasks)
+{
+    staticThreadPool_t* pool = worker->pool;
+    staticQueueItem_t*  item;
+    uint32_t            put  = 0;
+
+    pthread_mutex_lock(&worker->mutex);
+    while (put < num_tasks && staticQueuePut(&worker->queue, &item) == STATIC_QUEUE_SUCCESS) {
+        staticPoolTask_t* task = CONTAINER_OF(item, staticPoolTask_t, node);
+        task->fn               = fn;
+        task->arg              = args[put];
+        put++;
+    }
+    if (put > 0) {
+        __atomic_add_fetch(&pool->pending, put, __ATOMIC_ACQ_REL);
+    }
+    bool owner_asleep = worker->sleeping;
+    if (put > 0 && owner_asleep) {
+        __atomic_store_n(&worker->sleeping, false, __ATOMIC_RELAXED);
+        pthread_cond_signal(&worker->cond);
+    }
+    pthread_mutex_unlock(&worker->mutex);
+
+    // The owner is busy, let a sleeping worker take the new work instead of leaving it queued
+    if (put > 0 && !owner_asleep) {
+        wakeSleeper(pool, (uint32_t)(worker - pool->workers));
+    }
+
+    return put;
+}
+
+int32_t staticThreadPoolSubmit(staticThreadPool_t* pool, staticPoolTaskFn_t fn, void* arg)
+{
+    if (fn == NULL) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    // Give the task straight to a sleeping worker, else to the next shard in turn
+    staticThreadPoolWorker_t* sleeper = findSleeper(pool, t_next_shard);
+    uint32_t                  first   = sleeper != NULL ? (uint32_t)(sleeper - pool->workers) : t_next_shard++;
+
+    for (uint32_t i = 0; i < pool->num_workers; i++) {
+        if (submitShard(&pool->workers[(first + i) % pool->num_workers], fn, &arg, 1) == 1) {
+            return STATIC_QUEUE_SUCCESS;
+        }
+    }
+
+    return STATIC_QUEUE_FULL;
+}
+
+int32_t staticThreadPoolSubmitMany(staticThreadPool_t* pool, staticPoolTaskFn_t fn, void** args, uint32_t num_tasks)
+{
+    if (fn == NULL || args == NULL) {
+        return STATIC_QUEUE_INVALID;
+    }
+
+    // A single task skips the shared round robin counter
+    if (num_tasks == 1) {
+        int32_t result = staticThreadPoolSubmit(pool, fn, args[0]);
+        return result < 0 ? result : 1;
+    }
+
+    // Spread the batch evenly, and move on to the next shard when one is full
+    uint32_t submitted = 0;
+    uint32_t share     = (num_tasks + pool->num_workers - 1) / pool->num_workers;
+    for (uint32_t i = 0; i < pool->num_workers && submitted < num_tasks; i++) {
+        uint32_t shard = __atomic_fetch_add(&pool->next_shard, 1, __ATOMIC_RELAXED) % pool->num_workers;
+        uint32_t want  = num_tasks - submitted < share ? num_tasks - submitted : share;
+        submitted += submitShard(&pool->workers[shard], fn, &args[submitted], want);
+    }
+    for (uint32_t i = 0; i < pool->num_workers && submitted < num_tasks; i++) {
+        submitted += submitShard(&pool->workers[i], fn, &args[submitted], num_tasks - submitted);
+    }
+
+    if (submitted == 0 && num_tasks > 0) {
+        return STATIC_QUEUE_FULL;
+    }
+
+    return submitted;
+}
+
+void staticThreadPoolWaitAll(staticThreadPool_t* pool)
+{
+    pthread_mutex_lock(&pool->idle_mutex);
+    while (__atomic_load_n(&pool->pending, __ATOMIC_ACQUIRE) != 0) {
+        pthread_cond_wait(&pool->idle_cond, &pool->idle_mutex);
+    }
+    pthread_mutex_unlock(&pool->idle_mutex);
+}
+
+void staticThreadPoolDestroy(staticThreadPool_t* pool)
+{
+    __atomic_store_n(&pool->stop, true, __ATOMIC_RELEASE);
+
+    for (uint32_t i = 0; i < pool->num_workers; i++) {
+        pthread_mutex_lock(&pool->workers[i].mutex);
+        pthread_cond_signal(&pool->workers[i].cond);
+        pthread_mutex_unlock(&pool->workers[i].mutex);
+    }
+
+    for (uint32_t i = 0; i < pool->num_workers; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+    destroyWorkers(pool->workers, 0, pool->num_workers);
+
+    pthread_mutex_destroy(&pool->idle_mutex);
+    pthread_cond_destroy(&pool->idle_cond);
+}
@@ -0,0 +1,132 @@
+/**
+ * @file:       static_thread_pool.h
+ * @author:     Lucas Wennerholm <lucas.wennerholm@gmail.com>
+ * @brief:      Header file for static thread pool module
+ *
+ * @license: MIT License
+ *
+ * Copyright (c) 2024 Lucas Wennerholm
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#ifndef INC_STATIC_THREAD_POOL_H_
+#define INC_STATIC_THREAD_POOL_H_
+
+#include "static_queue.h"
+#include <pthread.h>
+
+/**
+ * A fixed size thread pool for short tasks that never allocates. Submitted tasks are stored in
+ * static queues of task records, one queue per worker. A single task goes to a sleeping worker if
+ * there is one, else to the next shard in round robin order, and batches are spread over the
+ * shards. A worker serves its own shard first and takes work from the other shards, an idle
+ * worker scans a few more rounds before it sleeps on a condition variable. Work put in the shard
+ * of a busy worker wakes a sleeping one to take it.
+ *
+ *     staticPoolTask_t         tasks[NUM_WORKERS * TASKS_PER_WORKER];
+ *     staticThreadPoolWorker_t workers[NUM_WORKERS];
+ *     staticThreadPool_t       pool;
+ *
+ *     staticThreadPoolInit(&pool, workers, NUM_WORKERS, tasks, TASKS_PER_WORKER);
+ *     staticThreadPoolSubmit(&pool, myTask, &my_arg);
+ *     staticThreadPoolWaitAll(&pool);
+ *     staticThreadPoolDestroy(&pool);
+ *
+ * Submit returns STATIC_QUEUE_FULL instead of blocking when every shard is full.
+ */
+
+typedef void (*staticPoolTaskFn_t)(void* arg);
+
+typedef struct {
+    staticPoolTaskFn_t fn;
+    void*              arg;
+    staticQueueItem_t  node;
+} staticPoolTask_t;
+
+typedef struct staticThreadPool staticThreadPool_t;
+
+typedef struct {
+    staticQueue_t       queue;
+    pthread_mutex_t     mutex;
+    pthread_cond_t      cond;
+    pthread_t           thread;
+    staticThreadPool_t* pool;
+    bool                sleeping; // Waiting on cond, read without the lock by submitters
+} staticThreadPoolWorker_t;
+
+struct staticThreadPool {
+    staticThreadPoolWorker_t* workers;
+    uint32_t                  num_workers;
+    uint32_t                  next_shard; // Round robin start of the batches, only a hint
+    uint32_t                  pending;    // Submitted tasks that have not finished
+    bool                      stop;
+    pthread_mutex_t           idle_mutex;
+    pthread_cond_t            idle_cond;
+};
+
+/**
+ * Initialize a thread pool and start its workers
+ * Input: Pool instance
+ * Input: Array of workers, one thread each
+ * Input: Number of workers
+ * Input: Task records, num_workers * tasks_per_worker
+ * Input: Size of the task queue of each worker
+ * Returns: queueErr_t, STATIC_QUEUE_IO_ERROR if a thread, mutex or condition variable could not
+ *          be created, everything created before it is cleaned up again
+ */
+int32_t staticThreadPoolInit(staticThreadPool_t*       pool,
+                             staticThreadPoolWorker_t* workers,
+                             uint32_t                  num_workers,
+                             staticPoolTask_t*         tasks,
+                             uint32_t                  tasks_per_worker);
+
+/**
+ * Submit a task
+ * Input: Pool instance
+ * Input: Task function
+ * Input: Argument passed to the task function
+ * Returns: queueErr_t, STATIC_QUEUE_FULL if no shard has room
+ */
+int32_t staticThreadPoolSubmit(staticThreadPool_t* pool, staticPoolTaskFn_t fn, void* arg);
+
+/**
+ * Submit several tasks with one lock and one wakeup per shard
+ * Input: Pool instance
+ * Input: Task function
+ * Input: Array of arguments, one task per argument
+ * Input: Number of tasks
+ * Returns: Number of tasks submitted, or negative error code
+ */
+int32_t staticThreadPoolSubmitMany(staticThreadPool_t* pool, staticPoolTaskFn_t fn, void** args, uint32_t num_tasks);
+
+/**
+ * Wait until every submitted task has finished
+ * Input: Pool instance
+ */
+void staticThreadPoolWaitAll(staticThreadPool_t* pool);
+
+/**
+ * Finish the queued tasks and stop the workers
+ * Input: Pool instance
+ */
+void staticThreadPoolDestroy(staticThreadPool_t* pool);
+
+#endif /* INC_STATIC_THREAD_POOL_H_ */
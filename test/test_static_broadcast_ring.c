@@ -0,0 +1,186 @@
+#include "static_broadcast_ring.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+typedef struct {
+    uint32_t number;
+} mySlot_t;
+
+#define RING_LEN 8
+#define STREAM_RING_LEN 256
+#define STREAM_LEN 20000
+
+static staticBroadcastRing_t     g_ring;
+static mySlot_t                  g_slots[RING_LEN];
+static mySlot_t                  g_stream_slots[STREAM_RING_LEN];
+static staticBroadcastConsumer_t g_consumers[3];
+
+static int32_t ringPut(staticBroadcastRing_t* ring, uint32_t data)
+{
+    void*   slot;
+    int32_t result = staticBroadcastRingClaim(ring, &slot);
+
+    if (result == STATIC_QUEUE_SUCCESS) {
+        ((mySlot_t*)slot)->number = data;
+        result = staticBroadcastRingPublish(ring);
+    }
+
+    return result;
+}
+
+static void* consumerThread(void* arg)
+{
+    staticBroadcastConsumer_t* consumer = (staticBroadcastConsumer_t*)arg;
+    uint32_t                   expected = 0;
+
+    while (expected < STREAM_LEN) {
+        void*   first;
+        int32_t num = staticBroadcastRingPeekBatch(&g_ring, consumer, &first, STREAM_RING_LEN);
+        for (int32_t i = 0; i < num; i++) {
+            if (((mySlot_t*)first)[i].number != expected) {
+                return (void*)1;
+            }
+            expected++;
+        }
+        if (num > 0) {
+            staticBroadcastRingRelease(&g_ring, consumer, num);
+        } else {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+int main() {
+
+    int32_t result = STATIC_BROADCAST_RING_INIT(&g_ring, g_slots);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        printf("Ring init failed %i\n", result);
+        return 1;
+    }
+
+    staticBroadcastRingAddConsumer(&g_ring, &g_consumers[0]);
+    staticBroadcastRingAddConsumer(&g_ring, &g_consumers[1]);
+
+    // Test 1: Every consumer sees every item
+    printf("\nTest 1: Multicast to all consumers\n");
+    for (uint32_t i = 0; i < 5; i++) {
+        result = ringPut(&g_ring, i);
+        if (result != STATIC_QUEUE_SUCCESS) {
+            printf("Put failed %i\n", result);
+            return 1;
+        }
+    }
+
+    for (int c = 0; c < 2; c++) {
+        if (staticBroadcastRingAvailable(&g_ring, &g_consumers[c]) != 5) {
+            printf("Expected 5 items for consumer %i\n", c);
+            return 1;
+        }
+
+        for (uint32_t i = 0; i < 5; i++) {
+            void* slot;
+            result = staticBroadcastRingPeek(&g_ring, &g_consumers[c], &slot);
+            if (result != STATIC_QUEUE_SUCCESS || ((mySlot_t*)slot)->number != i) {
+                printf("Consumer %i expected %u (result: %i)\n", c, i, result);
+                return 1;
+            }
+            staticBroadcastRingRelease(&g_ring, &g_consumers[c], 1);
+        }
+    }
+    printf("Test 1 passed: All consumers saw all items\n");
+
+    // Test 2: Producer is gated by the slowest consumer
+    printf("\nTest 2: Slow consumer gates producer\n");
+    for (uint32_t i = 0; i < RING_LEN; i++) {
+        ringPut(&g_ring, i);
+    }
+
+    result = ringPut(&g_ring, 99);
+    if (result != STATIC_QUEUE_FULL) {
+        printf("Expected STATIC_QUEUE_FULL, got %i\n", result);
+        return 1;
+    }
+
+    // The fast consumer catches up, the slow one still holds the ring
+    void*   first;
+    int32_t num = staticBroadcastRingPeekBatch(&g_ring, &g_consumers[0], &first, RING_LEN);
+    staticBroadcastRingRelease(&g_ring, &g_consumers[0], num);
+    num += staticBroadcastRingPeekBatch(&g_ring, &g_consumers[0], &first, RING_LEN);
+    staticBroadcastRingRelease(&g_ring, &g_consumers[0], staticBroadcastRingAvailable(&g_ring, &g_consumers[0]));
+    if (num != RING_LEN || ringPut(&g_ring, 99) != STATIC_QUEUE_FULL) {
+        printf("Expected producer to stay gated by the slow consumer\n");
+        return 1;
+    }
+
+    staticBroadcastRingRelease(&g_ring, &g_consumers[1], 2);
+    if (ringPut(&g_ring, 100) != STATIC_QUEUE_SUCCESS || ringPut(&g_ring, 101) != STATIC_QUEUE_SUCCESS ||
+        ringPut(&g_ring, 102) != STATIC_QUEUE_FULL) {
+        printf("Expected two free slots after slow consumer released two\n");
+        return 1;
+    }
+    printf("Test 2 passed: Producer gated\n");
+
+    // Test 3: Batches stop at the end of the slot array
+    printf("\nTest 3: Batch does not cross the wrap\n");
+    num = staticBroadcastRingPeekBatch(&g_ring, &g_consumers[0], &first, RING_LEN);
+    if (num != 2 || ((mySlot_t*)first)[0].number != 100) {
+        printf("Expected 2 items starting at 100, got %i\n", num);
+        return 1;
+    }
+
+    // The slow consumer is at the last slot of the array
+    num = staticBroadcastRingPeekBatch(&g_ring, &g_consumers[1], &first, RING_LEN);
+    if (num != 1 || ((mySlot_t*)first)[0].number != 2) {
+        printf("Expected 1 item up to the wrap, got %i\n", num);
+        return 1;
+    }
+    staticBroadcastRingRelease(&g_ring, &g_consumers[1], 1);
+
+    num = staticBroadcastRingPeekBatch(&g_ring, &g_consumers[1], &first, RING_LEN);
+    if (num != RING_LEN - 1 || ((mySlot_t*)first)[0].number != 3 || first != (void*)g_slots) {
+        printf("Expected %i items from the start of the array, got %i\n", RING_LEN - 1, num);
+        return 1;
+    }
+
+    result = staticBroadcastRingRelease(&g_ring, &g_consumers[1], RING_LEN + 1);
+    if (result != STATIC_QUEUE_INVALID) {
+        printf("Expected STATIC_QUEUE_INVALID when releasing too much, got %i\n", result);
+        return 1;
+    }
+    printf("Test 3 passed: Batch bounded by the wrap\n");
+
+    // Test 4: One producer and three consumer threads
+    printf("\nTest 4: Concurrent consumers\n");
+    STATIC_BROADCAST_RING_INIT(&g_ring, g_stream_slots);
+    pthread_t threads[3];
+    for (int c = 0; c < 3; c++) {
+        staticBroadcastRingAddConsumer(&g_ring, &g_consumers[c]);
+    }
+    for (int c = 0; c < 3; c++) {
+        pthread_create(&threads[c], NULL, consumerThread, &g_consumers[c]);
+    }
+
+    for (uint32_t i = 0; i < STREAM_LEN;) {
+        if (ringPut(&g_ring, i) == STATIC_QUEUE_SUCCESS) {
+            i++;
+        } else {
+            sched_yield();
+        }
+    }
+
+    for (int c = 0; c < 3; c++) {
+        void* thread_result;
+        pthread_join(threads[c], &thread_result);
+        if (thread_result != NULL) {
+            printf("Consumer %i saw items out of order\n", c);
+            return 1;
+        }
+    }
+    printf("Test 4 passed: %u items delivered to 3 consumers\n", STREAM_LEN);
+
+    printf("\nTest Done\n");
+    return 0;
+}
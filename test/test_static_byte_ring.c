@@ -0,0 +1,257 @@
+#include "static_byte_ring.h"
+#include <stdio.h>
+#include <string.h>
+
+#define RING_SIZE 64
+
+static int32_t ringWrite(staticByteRing_t* ring, const char* str)
+{
+    uint8_t* data;
+    uint32_t len    = strlen(str);
+    int32_t  result = staticByteRingReserve(ring, len, &data);
+
+    if (result == STATIC_QUEUE_SUCCESS) {
+        memcpy(data, str, len);
+        result = staticByteRingCommit(ring, len);
+    }
+
+    return result;
+}
+
+static int32_t ringRead(staticByteRing_t* ring, char* str)
+{
+    uint8_t* data;
+    uint32_t len;
+    int32_t  result = staticByteRingPeek(ring, &data, &len);
+
+    if (result == STATIC_QUEUE_SUCCESS) {
+        memcpy(str, data, len);
+        str[len] = '\0';
+        result = staticByteRingRelease(ring);
+    }
+
+    return result;
+}
+
+int main() {
+
+    staticByteRing_t ring;
+    uint32_t         buffer[RING_SIZE / sizeof(uint32_t)];
+    char             str[RING_SIZE];
+
+    int32_t result = STATIC_BYTE_RING_INIT(&ring, buffer);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        printf("Ring init failed %i\n", result);
+        return 1;
+    }
+
+    // Test 1: Write and read back records of different sizes
+    printf("\nTest 1: Basic write and read\n");
+    if (ringWrite(&ring, "hello") != STATIC_QUEUE_SUCCESS ||
+        ringWrite(&ring, "a") != STATIC_QUEUE_SUCCESS ||
+        ringWrite(&ring, "static queue") != STATIC_QUEUE_SUCCESS) {
+        printf("Ring write failed\n");
+        return 1;
+    }
+
+    if (staticByteRingGetNumRecords(&ring) != 3) {
+        printf("Expected 3 records, got %u\n", staticByteRingGetNumRecords(&ring));
+        return 1;
+    }
+
+    const char* expected[] = {"hello", "a", "static queue"};
+    for (int i = 0; i < 3; i++) {
+        result = ringRead(&ring, str);
+        if (result != STATIC_QUEUE_SUCCESS || strcmp(str, expected[i]) != 0) {
+            printf("Expected %s, got %s (result: %i)\n", expected[i], str, result);
+            return 1;
+        }
+    }
+
+    result = ringRead(&ring, str);
+    if (result != STATIC_QUEUE_EMPTY || !staticByteRingEmpty(&ring)) {
+        printf("Expected empty ring, got %i\n", result);
+        return 1;
+    }
+    printf("Test 1 passed: Records read back in order\n");
+
+    // Test 2: Reserved data is not visible until committed
+    printf("\nTest 2: Reserve is not visible before commit\n");
+    uint8_t* data;
+    result = staticByteRingReserve(&ring, 8, &data);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        printf("Reserve failed %i\n", result);
+        return 1;
+    }
+
+    if (!staticByteRingEmpty(&ring)) {
+        printf("Ring should be empty before commit\n");
+        return 1;
+    }
+
+    result = staticByteRingReserve(&ring, 8, &data);
+    if (result != STATIC_QUEUE_INVALID) {
+        printf("Expected STATIC_QUEUE_INVALID on second reserve, got %i\n", result);
+        return 1;
+    }
+
+    // Commit fewer bytes than reserved
+    memcpy(data, "abc", 3);
+    result = staticByteRingCommit(&ring, 3);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        printf("Commit failed %i\n", result);
+        return 1;
+    }
+
+    result = ringRead(&ring, str);
+    if (result != STATIC_QUEUE_SUCCESS || strcmp(str, "abc") != 0) {
+        printf("Expected abc, got %s (result: %i)\n", str, result);
+        return 1;
+    }
+
+    result = staticByteRingCommit(&ring, 1);
+    if (result != STATIC_QUEUE_INVALID) {
+        printf("Expected STATIC_QUEUE_INVALID on commit without reserve, got %i\n", result);
+        return 1;
+    }
+    printf("Test 2 passed: Reserve and commit\n");
+
+    // Test 3: Full ring and oversized records
+    printf("\nTest 3: Full ring\n");
+    staticByteRingInit(&ring, buffer, sizeof(buffer));
+
+    // Each 12 byte payload uses 16 bytes, 4 fit in the ring
+    for (int i = 0; i < 4; i++) {
+        result = ringWrite(&ring, "0123456789ab");
+        if (result != STATIC_QUEUE_SUCCESS) {
+            printf("Write %i failed %i\n", i, result);
+            return 1;
+        }
+    }
+
+    result = ringWrite(&ring, "");
+    if (result != STATIC_QUEUE_FULL) {
+        printf("Expected STATIC_QUEUE_FULL, got %i\n", result);
+        return 1;
+    }
+
+    result = staticByteRingReserve(&ring, RING_SIZE, &data);
+    if (result != STATIC_QUEUE_INVALID) {
+        printf("Expected STATIC_QUEUE_INVALID for oversized record, got %i\n", result);
+        return 1;
+    }
+    printf("Test 3 passed: Full ring detected\n");
+
+    // Test 4: Records are never split across the end of the buffer
+    printf("\nTest 4: Wrap around without splitting records\n");
+    staticByteRingInit(&ring, buffer, sizeof(buffer));
+
+    // 3 * 16 bytes, leaves 16 bytes at the end
+    ringWrite(&ring, "0123456789ab");
+    ringWrite(&ring, "0123456789ab");
+    ringWrite(&ring, "0123456789ab");
+    ringRead(&ring, str);
+    ringRead(&ring, str);
+
+    // 24 bytes does not fit in the 16 at the end, should be placed at the start
+    result = staticByteRingReserve(&ring, 20, &data);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        printf("Wrapped reserve failed %i\n", result);
+        return 1;
+    }
+
+    if (data != (uint8_t*)buffer + STATIC_BYTE_RING_HEADER_SIZE) {
+        printf("Expected wrapped record at start of buffer\n");
+        return 1;
+    }
+
+    memcpy(data, "wrapped record here!", 20);
+    staticByteRingCommit(&ring, 20);
+
+    result = ringRead(&ring, str);
+    if (result != STATIC_QUEUE_SUCCESS || strcmp(str, "0123456789ab") != 0) {
+        printf("Expected 0123456789ab, got %s (result: %i)\n", str, result);
+        return 1;
+    }
+
+    result = ringRead(&ring, str);
+    if (result != STATIC_QUEUE_SUCCESS || strcmp(str, "wrapped record here!") != 0) {
+        printf("Expected wrapped record, got %s (result: %i)\n", str, result);
+        return 1;
+    }
+
+    if (!staticByteRingEmpty(&ring)) {
+        printf("Ring should be empty\n");
+        return 1;
+    }
+    printf("Test 4 passed: Record placed at start instead of split\n");
+
+    // Test 5: Wrap when the reader drains the ring while the reservation is pending
+    printf("\nTest 5: Reader catches up during wrapped reservation\n");
+    staticByteRingInit(&ring, buffer, sizeof(buffer));
+
+    ringWrite(&ring, "0123456789ab");
+    ringWrite(&ring, "0123456789ab");
+    ringWrite(&ring, "0123456789ab");
+    ringRead(&ring, str);
+    ringRead(&ring, str);
+
+    result = staticByteRingReserve(&ring, 20, &data);
+    ringRead(&ring, str);
+    memcpy(data, "wrapped record here!", 20);
+    staticByteRingCommit(&ring, 20);
+
+    result = ringRead(&ring, str);
+    if (result != STATIC_QUEUE_SUCCESS || strcmp(str, "wrapped record here!") != 0) {
+        printf("Expected wrapped record, got %s (result: %i)\n", str, result);
+        return 1;
+    }
+    printf("Test 5 passed: Wrapped record read after reader caught up\n");
+
+    // Test 6: Cancel a reservation
+    printf("\nTest 6: Cancel reservation\n");
+    staticByteRingReserve(&ring, 8, &data);
+    result = staticByteRingCancel(&ring);
+    if (result != STATIC_QUEUE_SUCCESS || !staticByteRingEmpty(&ring)) {
+        printf("Cancel failed %i\n", result);
+        return 1;
+    }
+    printf("Test 6 passed: Reservation cancelled\n");
+
+    // Test 7: Long run of mixed sizes
+    printf("\nTest 7: Mixed size stream\n");
+    staticByteRingInit(&ring, buffer, sizeof(buffer));
+    uint32_t written = 0;
+    uint32_t read    = 0;
+    for (uint32_t i = 0; i < 1000; i++) {
+        uint32_t len = (i * 7) % 23;
+        if (staticByteRingReserve(&ring, len, &data) == STATIC_QUEUE_SUCCESS) {
+            memset(data, (uint8_t)written, len);
+            staticByteRingCommit(&ring, len);
+            written++;
+        }
+
+        if (i % 3 != 0) {
+            uint32_t rlen;
+            if (staticByteRingPeek(&ring, &data, &rlen) == STATIC_QUEUE_SUCCESS) {
+                for (uint32_t j = 0; j < rlen; j++) {
+                    if (data[j] != (uint8_t)read) {
+                        printf("Data mismatch in record %u\n", read);
+                        return 1;
+                    }
+                }
+                staticByteRingRelease(&ring);
+                read++;
+            }
+        }
+    }
+
+    if (written - read != staticByteRingGetNumRecords(&ring)) {
+        printf("Record count mismatch\n");
+        return 1;
+    }
+    printf("Test 7 passed: %u records streamed\n", written);
+
+    printf("\nTest Done\n");
+    return 0;
+}
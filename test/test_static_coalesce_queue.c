@@ -0,0 +1,133 @@
+#include "static_coalesce_queue.h"
+#include <stdio.h>
+
+typedef struct {
+    int32_t              number;
+    staticCoalesceItem_t entry;
+} myList_t;
+
+#define QUEUE_LEN 8
+
+static int32_t coalescePut(staticCoalesceQueue_t* coalesce_queue, uint64_t key, int32_t data, bool* merged)
+{
+    staticCoalesceItem_t* item;
+    int32_t               result = staticCoalesceQueuePut(coalesce_queue, key, &item, merged);
+
+    if (result == STATIC_QUEUE_SUCCESS) {
+        myList_t* next = CONTAINER_OF(item, myList_t, entry);
+        next->number = data;
+    }
+
+    return result;
+}
+
+static int checkPops(staticCoalesceQueue_t* coalesce_queue, const uint64_t* keys, const int32_t* data, int num)
+{
+    staticCoalesceItem_t* item;
+
+    for (int i = 0; i < num; i++) {
+        int32_t   result = staticCoalesceQueuePop(coalesce_queue, &item);
+        myList_t* popped = CONTAINER_OF(item, myList_t, entry);
+        if (result != STATIC_QUEUE_SUCCESS || item->key != keys[i] || popped->number != data[i]) {
+            printf("Expected key %lu data %i, got key %lu data %i (result: %i)\n",
+                   (unsigned long)keys[i], data[i], (unsigned long)item->key, popped->number, result);
+            return 1;
+        }
+    }
+
+    if (!staticCoalesceQueueEmpty(coalesce_queue)) {
+        printf("Expected an empty queue\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int main() {
+
+    myList_t              list[QUEUE_LEN] = {0};
+    staticCoalesceItem_t* index[2 * QUEUE_LEN];
+    staticCoalesceQueue_t coalesce_queue;
+    bool                  merged;
+
+    int32_t result = STATIC_COALESCE_QUEUE_INIT(&coalesce_queue, list, QUEUE_LEN, index, false);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        printf("Coalescing queue init failed %i\n", result);
+        return 1;
+    }
+
+    // Test 1: Updates for a queued key are merged in place and keep their position
+    printf("\nTest 1: Merge in place\n");
+    coalescePut(&coalesce_queue, 7, 70, &merged);
+    coalescePut(&coalesce_queue, 8, 80, &merged);
+    coalescePut(&coalesce_queue, 7, 71, &merged);
+    if (!merged || staticQueueGetNumItems(&coalesce_queue.queue) != 2) {
+        printf("Expected the second put of key 7 to merge\n");
+        return 1;
+    }
+
+    const uint64_t keep_keys[] = {7, 8};
+    const int32_t  keep_data[] = {71, 80};
+    if (checkPops(&coalesce_queue, keep_keys, keep_data, 2)) {
+        return 1;
+    }
+
+    // A popped key is queued again as a new item
+    coalescePut(&coalesce_queue, 7, 72, &merged);
+    if (merged) {
+        printf("Expected a popped key to take a new slot\n");
+        return 1;
+    }
+    staticCoalesceQueueErase(&coalesce_queue, 7);
+    printf("Test 1 passed: Duplicate keys merged\n");
+
+    // Test 2: A full queue still accepts updates for queued keys
+    printf("\nTest 2: Merge into a full queue\n");
+    for (int i = 0; i < QUEUE_LEN; i++) {
+        coalescePut(&coalesce_queue, 100 + i, i, NULL);
+    }
+
+    result = coalescePut(&coalesce_queue, 200, 0, NULL);
+    if (result != STATIC_QUEUE_FULL) {
+        printf("Expected STATIC_QUEUE_FULL, got %i\n", result);
+        return 1;
+    }
+
+    result = coalescePut(&coalesce_queue, 103, 33, &merged);
+    if (result != STATIC_QUEUE_SUCCESS || !merged) {
+        printf("Expected a merge into the full queue, got %i\n", result);
+        return 1;
+    }
+
+    result = staticCoalesceQueueErase(&coalesce_queue, 105);
+    if (result != STATIC_QUEUE_SUCCESS ||
+        staticCoalesceQueueErase(&coalesce_queue, 105) != STATIC_QUEUE_NOT_IN_QUEUE) {
+        printf("Expected erase of 105 once, got %i\n", result);
+        return 1;
+    }
+
+    const uint64_t full_keys[] = {100, 101, 102, 103, 104, 106, 107};
+    const int32_t  full_data[] = {0, 1, 2, 33, 4, 6, 7};
+    if (checkPops(&coalesce_queue, full_keys, full_data, 7)) {
+        return 1;
+    }
+    printf("Test 2 passed: Full queue merges\n");
+
+    // Test 3: Refresh mode moves a merged item to the end
+    printf("\nTest 3: Refresh position\n");
+    STATIC_COALESCE_QUEUE_INIT(&coalesce_queue, list, QUEUE_LEN, index, true);
+    coalescePut(&coalesce_queue, 1, 10, NULL);
+    coalescePut(&coalesce_queue, 2, 20, NULL);
+    coalescePut(&coalesce_queue, 3, 30, NULL);
+    coalescePut(&coalesce_queue, 1, 11, NULL);
+
+    const uint64_t refresh_keys[] = {2, 3, 1};
+    const int32_t  refresh_data[] = {20, 30, 11};
+    if (checkPops(&coalesce_queue, refresh_keys, refresh_data, 3)) {
+        return 1;
+    }
+    printf("Test 3 passed: Merged item refreshed\n");
+
+    printf("\nTest Done\n");
+    return 0;
+}
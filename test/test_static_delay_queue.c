@@ -0,0 +1,191 @@
+#include "static_delay_queue.h"
+#include <stdio.h>
+
+typedef struct {
+    int32_t           number;
+    staticDelayItem_t delay;
+} myList_t;
+
+#define QUEUE_LEN 256
+
+static int32_t delayPut(staticDelayQueue_t* delay_queue, uint64_t deadline, int32_t data)
+{
+    staticDelayItem_t* item;
+    int32_t            result = staticDelayQueuePut(delay_queue, deadline, &item);
+
+    if (result == STATIC_QUEUE_SUCCESS) {
+        myList_t* next = CONTAINER_OF(item, myList_t, delay);
+        next->number = data;
+    }
+
+    return result;
+}
+
+static uint32_t rand_state = 12345;
+static uint32_t testRand(void)
+{
+    rand_state = rand_state * 1103515245u + 12345u;
+    return rand_state >> 8;
+}
+
+// Rebuild the bucket index from the queue and compare, returns false on a mismatch
+static bool indexMatches(staticDelayQueue_t* delay_queue)
+{
+    staticQueueItem_t* bucket_last[STATIC_DELAY_QUEUE_BUCKETS] = {0};
+    uint32_t           non_empty = 0;
+
+    if (!staticQueueEmpty(&delay_queue->queue)) {
+        staticQueueItem_t* node = delay_queue->queue.tail;
+        do {
+            staticDelayItem_t* item   = CONTAINER_OF(node, staticDelayItem_t, node);
+            uint64_t           bucket = item->deadline <= delay_queue->base ? 0 :
+                                        (item->deadline - delay_queue->base) >> delay_queue->shift;
+            if (bucket >= STATIC_DELAY_QUEUE_BUCKETS) {
+                bucket = STATIC_DELAY_QUEUE_BUCKETS - 1;
+            }
+            bucket_last[bucket] = node;
+            non_empty |= 0x80000000u >> bucket;
+            node = node->next;
+        } while (node != delay_queue->queue.head);
+    }
+
+    for (uint32_t bucket = 0; bucket < STATIC_DELAY_QUEUE_BUCKETS; bucket++) {
+        if (bucket_last[bucket] != delay_queue->bucket_last[bucket]) {
+            return false;
+        }
+    }
+
+    return non_empty == delay_queue->non_empty;
+}
+
+int main() {
+
+    myList_t           list[QUEUE_LEN] = {0};
+    staticDelayQueue_t delay_queue;
+    staticDelayItem_t* item;
+
+    int32_t result = STATIC_DELAY_QUEUE_INIT(&delay_queue, list, QUEUE_LEN, 4);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        printf("Delay queue init failed %i\n", result);
+        return 1;
+    }
+
+    // Test 1: Pop in deadline order, equal deadlines keep put order
+    printf("\nTest 1: Pop in deadline order\n");
+    delayPut(&delay_queue, 100, 1);
+    delayPut(&delay_queue, 50, 2);
+    delayPut(&delay_queue, 100, 3);
+    delayPut(&delay_queue, 5000, 4);
+    delayPut(&delay_queue, 75, 5);
+
+    int32_t expected[] = {2, 5, 1, 3, 4};
+    for (int i = 0; i < 5; i++) {
+        result = staticDelayQueuePopIfDue(&delay_queue, 10000, &item);
+        myList_t* popped = CONTAINER_OF(item, myList_t, delay);
+        if (result != STATIC_QUEUE_SUCCESS || popped->number != expected[i]) {
+            printf("Expected %i, got %i (result: %i)\n", expected[i], popped->number, result);
+            return 1;
+        }
+    }
+    printf("Test 1 passed: Deadline order kept\n");
+
+    // Test 2: Nothing is returned before it is due
+    printf("\nTest 2: PopIfDue waits for the deadline\n");
+    delayPut(&delay_queue, 200, 1);
+    result = staticDelayQueuePopIfDue(&delay_queue, 199, &item);
+    if (result != STATIC_QUEUE_EMPTY || staticDelayQueueEmpty(&delay_queue)) {
+        printf("Expected STATIC_QUEUE_EMPTY before the deadline, got %i\n", result);
+        return 1;
+    }
+
+    result = staticDelayQueuePopIfDue(&delay_queue, 200, &item);
+    if (result != STATIC_QUEUE_SUCCESS || item->deadline != 200) {
+        printf("Expected the item at its deadline, got %i\n", result);
+        return 1;
+    }
+    printf("Test 2 passed: Items are held until due\n");
+
+    // Test 3: Random deadlines across and past the buckets, with erases, pop sorted
+    printf("\nTest 3: Random deadlines with erases\n");
+    staticDelayItem_t* erase_items[QUEUE_LEN];
+    int                num_erase = 0;
+
+    for (int i = 0; i < QUEUE_LEN; i++) {
+        uint64_t deadline = 1000 + (testRand() % 1200);
+        result = staticDelayQueuePut(&delay_queue, deadline, &item);
+        if (result != STATIC_QUEUE_SUCCESS) {
+            printf("Put %i failed %i\n", i, result);
+            return 1;
+        }
+        if (i % 5 == 0) {
+            erase_items[num_erase++] = item;
+        }
+    }
+
+    if (delayPut(&delay_queue, 0, 0) != STATIC_QUEUE_FULL) {
+        printf("Expected STATIC_QUEUE_FULL\n");
+        return 1;
+    }
+
+    for (int i = 0; i < num_erase; i++) {
+        result = staticDelayQueueErase(&delay_queue, erase_items[i]);
+        if (result != STATIC_QUEUE_SUCCESS) {
+            printf("Erase %i failed %i\n", i, result);
+            return 1;
+        }
+    }
+
+    // Refill the erased slots with deadlines before, inside and after the current range
+    for (int i = 0; i < num_erase; i++) {
+        delayPut(&delay_queue, testRand() % 3000, i);
+    }
+
+    uint64_t last_deadline = 0;
+    int      num_popped    = 0;
+    while (staticDelayQueuePopIfDue(&delay_queue, UINT64_MAX, &item) == STATIC_QUEUE_SUCCESS) {
+        if (item->deadline < last_deadline) {
+            printf("Deadline %lu popped after %lu\n", (unsigned long)item->deadline, (unsigned long)last_deadline);
+            return 1;
+        }
+        last_deadline = item->deadline;
+        num_popped++;
+    }
+
+    if (num_popped != QUEUE_LEN || delay_queue.non_empty != 0) {
+        printf("Expected %i items and an empty index, got %i items, index 0x%08x\n",
+               QUEUE_LEN, num_popped, delay_queue.non_empty);
+        return 1;
+    }
+    printf("Test 3 passed: Random deadlines popped in order\n");
+
+    // Test 4: A queue that never runs empty over a span far longer than the 32 buckets
+    printf("\nTest 4: Buckets rotate with the time\n");
+    uint64_t now = 0;
+    last_deadline = 0;
+    for (now = 0; now < 20000; now++) {
+        delayPut(&delay_queue, now + 1 + testRand() % 2000, 0);
+        while (staticDelayQueuePopIfDue(&delay_queue, now, &item) == STATIC_QUEUE_SUCCESS) {
+            if (item->deadline < last_deadline || item->deadline > now) {
+                printf("Deadline %lu popped at %lu\n", (unsigned long)item->deadline, (unsigned long)now);
+                return 1;
+            }
+            last_deadline = item->deadline;
+        }
+
+        if (now % 97 == 0 && !indexMatches(&delay_queue)) {
+            printf("Index out of sync at %lu\n", (unsigned long)now);
+            return 1;
+        }
+    }
+
+    // The earliest deadline is always in bucket 0
+    if (staticDelayQueueEmpty(&delay_queue) || delay_queue.base + 16 <= now || !indexMatches(&delay_queue)) {
+        printf("Expected the base to follow the time, base %lu at %lu\n", (unsigned long)delay_queue.base,
+               (unsigned long)now);
+        return 1;
+    }
+    printf("Test 4 passed: Base at %lu after %lu ticks\n", (unsigned long)delay_queue.base, (unsigned long)now);
+
+    printf("\nTest Done\n");
+    return 0;
+}
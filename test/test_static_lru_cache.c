@@ -0,0 +1,198 @@
+#include "static_lru_cache.h"
+#include <stdio.h>
+
+typedef struct {
+    int32_t         number;
+    staticLruItem_t entry;
+} myList_t;
+
+#define CACHE_LEN 16
+
+static uint64_t evicted_keys[64];
+static int      num_evicted = 0;
+
+static void onEvict(staticLruCache_t* cache, staticLruItem_t* item, void* ctx)
+{
+    (void)cache;
+    (*(int*)ctx)++;
+    evicted_keys[num_evicted++ % 64] = item->key;
+}
+
+static int32_t cachePut(staticLruCache_t* cache, uint64_t key, int32_t data)
+{
+    staticLruItem_t* item;
+    int32_t          result = staticLruCachePut(cache, key, &item);
+
+    if (result == STATIC_QUEUE_SUCCESS) {
+        myList_t* next = CONTAINER_OF(item, myList_t, entry);
+        next->number = data;
+    }
+
+    return result;
+}
+
+static int32_t cacheGet(staticLruCache_t* cache, uint64_t key, int32_t* data)
+{
+    staticLruItem_t* item;
+    int32_t          result = staticLruCacheGet(cache, key, &item);
+
+    if (result == STATIC_QUEUE_SUCCESS) {
+        myList_t* entry = CONTAINER_OF(item, myList_t, entry);
+        *data = entry->number;
+    }
+
+    return result;
+}
+
+static uint32_t rand_state = 2024;
+static uint32_t testRand(void)
+{
+    rand_state = rand_state * 1103515245u + 12345u;
+    return rand_state >> 8;
+}
+
+int main() {
+
+    myList_t         list[CACHE_LEN] = {0};
+    staticLruItem_t* index[2 * CACHE_LEN];
+    staticLruCache_t cache;
+    int              evict_count = 0;
+    int32_t          data;
+
+    int32_t result = STATIC_LRU_CACHE_INIT(&cache, list, CACHE_LEN, index);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        printf("Cache init failed %i\n", result);
+        return 1;
+    }
+    staticLruCacheSetEvictCallback(&cache, onEvict, &evict_count);
+
+    // Test 1: The least recently used entry is evicted, a get refreshes an entry
+    printf("\nTest 1: Eviction order\n");
+    for (int i = 0; i < CACHE_LEN; i++) {
+        cachePut(&cache, 1000 + i, i);
+    }
+
+    cacheGet(&cache, 1000, &data);
+    cachePut(&cache, 2000, 99);
+
+    if (evict_count != 1 || evicted_keys[0] != 1001) {
+        printf("Expected key 1001 evicted, got %i evictions, key %lu\n",
+               evict_count, (unsigned long)evicted_keys[0]);
+        return 1;
+    }
+
+    result = cacheGet(&cache, 1001, &data);
+    if (result != STATIC_QUEUE_NOT_IN_QUEUE) {
+        printf("Expected a miss for 1001, got %i\n", result);
+        return 1;
+    }
+
+    result = cacheGet(&cache, 1000, &data);
+    if (result != STATIC_QUEUE_SUCCESS || data != 0) {
+        printf("Expected 0 for key 1000, got %i (result: %i)\n", data, result);
+        return 1;
+    }
+    printf("Test 1 passed: Least recently used evicted\n");
+
+    // Test 2: Put on an existing key returns the same entry, remove does not call the callback
+    printf("\nTest 2: Put existing and remove\n");
+    cachePut(&cache, 1005, 55);
+    cacheGet(&cache, 1005, &data);
+    if (data != 55 || staticLruCacheGetNumItems(&cache) != CACHE_LEN) {
+        printf("Expected 55 and a full cache, got %i and %u\n", data, staticLruCacheGetNumItems(&cache));
+        return 1;
+    }
+
+    result = staticLruCacheRemove(&cache, 1005);
+    if (result != STATIC_QUEUE_SUCCESS || evict_count != 1 ||
+        cacheGet(&cache, 1005, &data) != STATIC_QUEUE_NOT_IN_QUEUE) {
+        printf("Remove failed %i\n", result);
+        return 1;
+    }
+
+    while (staticLruCacheEvict(&cache) == STATIC_QUEUE_SUCCESS) {
+    }
+    if (staticLruCacheGetNumItems(&cache) != 0 || evict_count != CACHE_LEN) {
+        printf("Expected an empty cache after evicting all, got %u items\n",
+               staticLruCacheGetNumItems(&cache));
+        return 1;
+    }
+    printf("Test 2 passed: Put existing and remove\n");
+
+    // Test 3: Random operations against a reference LRU kept as an array, newest last
+    printf("\nTest 3: Random operations against a reference\n");
+    uint64_t model[CACHE_LEN];
+    int      model_len = 0;
+
+    for (int op = 0; op < 20000; op++) {
+        uint64_t key  = testRand() % 48;
+        int      pos  = -1;
+        for (int i = 0; i < model_len; i++) {
+            if (model[i] == key) {
+                pos = i;
+            }
+        }
+
+        uint32_t action = testRand() % 3;
+        if (action == 0) {
+            result = cacheGet(&cache, key, &data);
+            if ((pos >= 0) != (result == STATIC_QUEUE_SUCCESS) || (pos >= 0 && data != (int32_t)key)) {
+                printf("Get %lu mismatch at op %i (result: %i)\n", (unsigned long)key, op, result);
+                return 1;
+            }
+        } else if (action == 1) {
+            cachePut(&cache, key, (int32_t)key);
+            if (pos < 0 && model_len == CACHE_LEN) {
+                for (int i = 1; i < model_len; i++) {
+                    model[i - 1] = model[i];
+                }
+                model[model_len - 1] = key;
+                continue;
+            }
+            if (pos < 0) {
+                model[model_len++] = key;
+                continue;
+            }
+        } else {
+            result = staticLruCacheRemove(&cache, key);
+            if ((pos >= 0) != (result == STATIC_QUEUE_SUCCESS)) {
+                printf("Remove %lu mismatch at op %i (result: %i)\n", (unsigned long)key, op, result);
+                return 1;
+            }
+            if (pos >= 0) {
+                for (int i = pos + 1; i < model_len; i++) {
+                    model[i - 1] = model[i];
+                }
+                model_len--;
+            }
+            continue;
+        }
+
+        // Hit on get or put, move to the newest position
+        if (pos >= 0) {
+            for (int i = pos + 1; i < model_len; i++) {
+                model[i - 1] = model[i];
+            }
+            model[model_len - 1] = key;
+        }
+    }
+
+    // Drain and compare the eviction order with the reference
+    num_evicted = 0;
+    for (int i = 0; i < model_len; i++) {
+        staticLruCacheEvict(&cache);
+        if (evicted_keys[i] != model[i]) {
+            printf("Expected eviction %i to be %lu, got %lu\n",
+                   i, (unsigned long)model[i], (unsigned long)evicted_keys[i]);
+            return 1;
+        }
+    }
+    if (staticLruCacheGetNumItems(&cache) != 0) {
+        printf("Expected an empty cache\n");
+        return 1;
+    }
+    printf("Test 3 passed: Cache matches the reference\n");
+
+    printf("\nTest Done\n");
+    return 0;
+}
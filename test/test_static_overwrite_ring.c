@@ -0,0 +1,118 @@
+#include "static_overwrite_ring.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+typedef struct {
+    uint32_t seq;
+    uint32_t check;
+} mySample_t;
+
+#define RING_LEN   16
+#define STREAM_LEN 200000
+
+static staticOverwriteRing_t g_ring;
+static mySample_t            g_samples[RING_LEN];
+static uint32_t              g_stamps[RING_LEN];
+
+static void ringWrite(uint32_t seq)
+{
+    void* slot;
+    staticOverwriteRingReserve(&g_ring, &slot);
+    ((mySample_t*)slot)->seq   = seq;
+    ((mySample_t*)slot)->check = ~seq;
+    staticOverwriteRingCommit(&g_ring);
+}
+
+static void* writerThread(void* arg)
+{
+    (void)arg;
+    for (uint32_t i = 0; i < STREAM_LEN; i++) {
+        ringWrite(i);
+        if (i % 64 == 0) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+int main() {
+
+    mySample_t snapshot[RING_LEN];
+    uint32_t   first_seq;
+
+    int32_t result = STATIC_OVERWRITE_RING_INIT(&g_ring, g_samples, g_stamps);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        printf("Ring init failed %i\n", result);
+        return 1;
+    }
+
+    // Test 1: Snapshot of a partially filled ring
+    printf("\nTest 1: Snapshot before wrap\n");
+    for (uint32_t i = 0; i < 5; i++) {
+        ringWrite(i);
+    }
+
+    int32_t num = staticOverwriteRingSnapshot(&g_ring, snapshot, RING_LEN, &first_seq);
+    if (num != 5 || first_seq != 0 || snapshot[4].seq != 4) {
+        printf("Expected 5 samples from 0, got %i from %u\n", num, first_seq);
+        return 1;
+    }
+    printf("Test 1 passed: Partial snapshot\n");
+
+    // Test 2: The newest samples are kept after wrapping
+    printf("\nTest 2: Snapshot after wrap\n");
+    for (uint32_t i = 5; i < 40; i++) {
+        ringWrite(i);
+    }
+
+    num = staticOverwriteRingSnapshot(&g_ring, snapshot, RING_LEN, &first_seq);
+    if (num != RING_LEN || first_seq != 40 - RING_LEN) {
+        printf("Expected %i samples from %i, got %i from %u\n", RING_LEN, 40 - RING_LEN, num, first_seq);
+        return 1;
+    }
+
+    for (int i = 0; i < num; i++) {
+        if (snapshot[i].seq != first_seq + i) {
+            printf("Expected sample %u, got %u\n", first_seq + i, snapshot[i].seq);
+            return 1;
+        }
+    }
+
+    num = staticOverwriteRingSnapshot(&g_ring, snapshot, 4, &first_seq);
+    if (num != 4 || first_seq != 36 || snapshot[3].seq != 39) {
+        printf("Expected the newest 4 samples, got %i from %u\n", num, first_seq);
+        return 1;
+    }
+    printf("Test 2 passed: Newest samples kept\n");
+
+    // Test 3: Snapshots taken while the writer is running are consistent
+    printf("\nTest 3: Concurrent snapshots\n");
+    STATIC_OVERWRITE_RING_INIT(&g_ring, g_samples, g_stamps);
+
+    pthread_t writer;
+    pthread_create(&writer, NULL, writerThread, NULL);
+
+    uint32_t snapshots = 0;
+    uint32_t last_seq  = 0;
+    while (last_seq < STREAM_LEN - 1) {
+        num = staticOverwriteRingSnapshot(&g_ring, snapshot, RING_LEN, &first_seq);
+        for (int i = 0; i < num; i++) {
+            if (snapshot[i].seq != first_seq + i || snapshot[i].check != ~snapshot[i].seq) {
+                printf("Torn or out of order sample %u at %i\n", snapshot[i].seq, i);
+                return 1;
+            }
+        }
+        if (num > 0) {
+            last_seq = snapshot[num - 1].seq;
+            snapshots++;
+        }
+        sched_yield();
+    }
+
+    pthread_join(writer, NULL);
+    printf("Test 3 passed: %u consistent snapshots\n", snapshots);
+
+    printf("\nTest Done\n");
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include "static_pipeline.h"
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    uint32_t          sequence;
+    uint32_t          value;
+    char              text[16];
+    staticQueueItem_t node;
+} myMsg_t;
+
+#define NUM_ITEMS  64
+#define NUM_STAGES 3
+#define LINK_SIZE  64
+#define TOTAL      100000u
+#define BATCH      16
+
+typedef struct {
+    uint32_t next;
+    uint32_t errors;
+} checkCtx_t;
+
+static int32_t parseStage(staticPipelineStage_t* stage, staticQueueItem_t* item, void* ctx)
+{
+    (void)stage;
+    uint32_t* produced = ctx;
+    if (*produced == TOTAL) {
+        return STATIC_QUEUE_CB_STOP;
+    }
+
+    myMsg_t* msg  = CONTAINER_OF(item, myMsg_t, node);
+    msg->sequence = *produced;
+    msg->value    = *produced;
+    (*produced)++;
+    return STATIC_QUEUE_CB_NEXT;
+}
+
+static int32_t enrichStage(staticPipelineStage_t* stage, staticQueueItem_t* item, void* ctx)
+{
+    (void)stage;
+    (void)ctx;
+    myMsg_t* msg = CONTAINER_OF(item, myMsg_t, node);
+    msg->value   = msg->value * 3 + 1;
+    return STATIC_QUEUE_CB_NEXT;
+}
+
+static int32_t serializeStage(staticPipelineStage_t* stage, staticQueueItem_t* item, void* ctx)
+{
+    (void)stage;
+    checkCtx_t* check = ctx;
+    myMsg_t*    msg   = CONTAINER_OF(item, myMsg_t, node);
+
+    snprintf(msg->text, sizeof(msg->text), "%u", msg->value);
+    if (msg->sequence != check->next || msg->value != msg->sequence * 3 + 1) {
+        check->errors++;
+    }
+    check->next++;
+    return STATIC_QUEUE_CB_NEXT;
+}
+
+int main() {
+
+    myMsg_t               items[NUM_ITEMS] = {0};
+    staticQueue_t         pool;
+    staticPipelineStage_t stages[NUM_STAGES];
+    staticPipelineLink_t  links[NUM_STAGES];
+    staticQueueItem_t*    link_slots[NUM_STAGES * LINK_SIZE];
+    staticPipeline_t      pipeline;
+    uint32_t              produced = 0;
+    checkCtx_t            check    = {0};
+
+    STATIC_QUEUE_INIT(&pool, items, NUM_ITEMS);
+
+    // Test 1: Items flow through all stages in order and are recycled to the source
+    printf("\nTest 1: Three stage pipeline\n");
+    int32_t result = staticPipelineInit(&pipeline, stages, links, NUM_STAGES, link_slots, LINK_SIZE, BATCH);
+    result |= staticPipelineSetStage(&pipeline, 0, "parse", parseStage, &produced, -1);
+    result |= staticPipelineSetStage(&pipeline, 1, "enrich", enrichStage, NULL, 0);
+    result |= staticPipelineSetStage(&pipeline, 2, "serialize", serializeStage, &check, -1);
+    result |= staticPipelineSeed(&pipeline, &pool);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        printf("Pipeline setup failed %i\n", result);
+        return 1;
+    }
+
+    if (staticPipelineSeed(&pipeline, &pool) != STATIC_QUEUE_FULL) {
+        printf("Expected STATIC_QUEUE_FULL when the links can not hold every item\n");
+        return 1;
+    }
+
+    result = staticPipelineStart(&pipeline);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        printf("Pipeline start failed %i\n", result);
+        return 1;
+    }
+    staticPipelineJoin(&pipeline);
+
+    if (check.next != TOTAL || check.errors != 0) {
+        printf("Expected %u items in order, got %u with %u errors\n", TOTAL, check.next, check.errors);
+        return 1;
+    }
+    printf("Test 1 passed: %u items passed through in order\n", TOTAL);
+
+    // Test 2: Every stage reports its throughput, and all items are back in front of the source
+    printf("\nTest 2: Stage stats\n");
+    for (uint32_t i = 0; i < NUM_STAGES; i++) {
+        staticPipelineStats_t stats;
+        staticPipelineGetStats(&pipeline, i, &stats);
+        printf("  %-10s %8lu items %10.0f items/s %8lu stalls, depth %u%s\n", stats.name,
+               (unsigned long)stats.items, stats.items_per_sec, (unsigned long)stats.stalls, stats.depth,
+               stats.pinned ? ", pinned" : "");
+
+        if (stats.items != TOTAL || stats.items_per_sec <= 0.0) {
+            printf("Expected %u items through %s, got %lu\n", TOTAL, stats.name, (unsigned long)stats.items);
+            return 1;
+        }
+        // The source drops the rest of its last batch when it stops
+        if (i == 0 && (stats.depth >= NUM_ITEMS || stats.depth + BATCH < NUM_ITEMS)) {
+            printf("Expected the recycled items waiting for the source, got %u\n", stats.depth);
+            return 1;
+        }
+    }
+    printf("Test 2 passed: Stats reported\n");
+
+    printf("\nTest Done\n");
+    return 0;
+}
@@ -8,6 +8,58 @@ typedef struct {
 
 #define LIST_LEN 4
 
+typedef struct {
+    uint64_t id;
+    uint64_t value;
+} myMsg_t;
+
+typedef struct {
+    myMsg_t           msg;
+    staticQueueItem_t node;
+} myMsgItem_t;
+
+typedef struct {
+    uint64_t          put_time;
+    int32_t           number;
+    staticQueueItem_t node;
+} stampedItem_t;
+
+#if STATIC_QUEUE_SEQLOCK
+#include <pthread.h>
+
+#define SEQLOCK_LIST_LEN 8
+
+static staticQueue_t g_seqlock_queue;
+static myMsgItem_t   g_seqlock_list[SEQLOCK_LIST_LEN];
+static bool          g_seqlock_done   = false;
+static uint32_t      g_seqlock_reads  = 0;
+static uint32_t      g_seqlock_errors = 0;
+
+// Check every snapshot and front copy while main keeps pushing and taking
+static void* seqlockReader(void* arg)
+{
+    (void)arg;  // Unused
+    while (!__atomic_load_n(&g_seqlock_done, __ATOMIC_ACQUIRE)) {
+        staticQueueSnapshot_t snapshot;
+        myMsg_t               msg;
+
+        staticQueueSnapshot(&g_seqlock_queue, &snapshot);
+        myMsgItem_t* head = CONTAINER_OF(snapshot.head, myMsgItem_t, node);
+        myMsgItem_t* tail = CONTAINER_OF(snapshot.tail, myMsgItem_t, node);
+        if ((tail - g_seqlock_list + snapshot.num_items) % SEQLOCK_LIST_LEN != (uint32_t)(head - g_seqlock_list)) {
+            g_seqlock_errors++;
+        }
+
+        if (staticQueuePeekCopy(&g_seqlock_queue, &msg) == STATIC_QUEUE_SUCCESS && msg.value != msg.id * 100) {
+            g_seqlock_errors++;
+        }
+        __atomic_add_fetch(&g_seqlock_reads, 1, __ATOMIC_RELAXED);
+    }
+
+    return NULL;
+}
+#endif
+
 static int32_t queuePut(staticQueue_t* queue,
                         uint32_t       data)
 {
@@ -148,6 +200,79 @@ static int32_t eraseOnly20Callback(staticQueue_t *q, staticQueueItem_t *item) {
     return STATIC_QUEUE_CB_NEXT;
 }
 
+static bool isEvenPredicate(staticQueue_t *q, staticQueueItem_t *item, void *ctx) {
+    (void)q;  // Unused
+    (void)ctx;  // Unused
+    myList_t* list_item = CONTAINER_OF(item, myList_t, node);
+    return list_item->number % 2 == 0;
+}
+
+static bool lessThanPredicate(staticQueue_t *q, staticQueueItem_t *item, void *ctx) {
+    (void)q;  // Unused
+    myList_t* list_item = CONTAINER_OF(item, myList_t, node);
+    return list_item->number < *(int32_t*)ctx;
+}
+
+typedef struct {
+    int32_t counter;
+    int32_t sum;
+} foreachCtx_t;
+
+static int32_t countCtxCallback(staticQueue_t *q, staticQueueItem_t *item, void *ctx) {
+    (void)q;  // Unused
+    foreachCtx_t* foreach_ctx = (foreachCtx_t*)ctx;
+    myList_t* list_item = CONTAINER_OF(item, myList_t, node);
+    foreach_ctx->counter++;
+    foreach_ctx->sum += list_item->number;
+    return STATIC_QUEUE_CB_NEXT;
+}
+
+static bool equalsPredicate(staticQueue_t *q, staticQueueItem_t *item, void *ctx) {
+    (void)q;  // Unused
+    myList_t* list_item = CONTAINER_OF(item, myList_t, node);
+    (*(int32_t*)ctx)--;
+    return list_item->number == 20;
+}
+
+static void swapCallback(staticQueueItem_t *a, staticQueueItem_t *b, void *ctx) {
+    (void)ctx;  // Unused
+    myList_t* item_a = CONTAINER_OF(a, myList_t, node);
+    myList_t* item_b = CONTAINER_OF(b, myList_t, node);
+    int32_t tmp = item_a->number;
+    item_a->number = item_b->number;
+    item_b->number = tmp;
+}
+
+static uint64_t g_now = 0;
+
+static uint64_t testClock(void *ctx) {
+    (void)ctx;  // Unused
+    return g_now;
+}
+
+static void watermarkCallback(staticQueue_t *q, bool high, void *ctx) {
+    (void)q;  // Unused
+    int32_t* crossings = (int32_t*)ctx;
+    crossings[high ? 1 : 0]++;
+}
+
+// Sheds the oldest item on a high crossing, the queue is consistent again when the callback runs
+static void shedCallback(staticQueue_t *q, bool high, void *ctx) {
+    int32_t* shed = (int32_t*)ctx;
+    staticQueueItem_t* item;
+#if STATIC_QUEUE_SEQLOCK
+    staticQueueSnapshot_t snapshot;
+    staticQueueSnapshot(q, &snapshot);
+    if (snapshot.num_items != (uint32_t)staticQueueGetNumItems(q)) {
+        return;
+    }
+#endif
+    if (high && staticQueuePop(q, &item) == STATIC_QUEUE_SUCCESS) {
+        myList_t* entry = CONTAINER_OF(item, myList_t, node);
+        *shed           = entry->number;
+    }
+}
+
 int main() {
 
     staticQueue_t queue;
@@ -1696,6 +1821,966 @@ int main() {
 
     printf("\n=== All staticQueueForEach tests passed ===\n");
 
+    // ===== Test staticQueueReserve/Commit functions =====
+    printf("\n=== Testing staticQueueReserve/Commit ===\n");
+
+    // Test 32: Reserved items are not visible until committed
+    printf("\nTest 32: Reserve hides item until commit\n");
+    queueClear(&queue);
+
+    staticQueueItem_t* reserved[LIST_LEN];
+    result = staticQueueReserve(&queue, &reserved[0]);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        printf("Reserve failed %i\n", result);
+        return 1;
+    }
+
+    result = staticQueuePeak(&queue, &item_to_erase);
+    if (result != STATIC_QUEUE_EMPTY) {
+        printf("Expected STATIC_QUEUE_EMPTY before commit, got %i\n", result);
+        return 1;
+    }
+
+    myList_t* reserved_item = CONTAINER_OF(reserved[0], myList_t, node);
+    reserved_item->number = 10;
+    result = staticQueueCommit(&queue, reserved[0]);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        printf("Commit failed %i\n", result);
+        return 1;
+    }
+
+    result = staticQueueCommit(&queue, reserved[0]);
+    if (result != STATIC_QUEUE_INVALID) {
+        printf("Expected STATIC_QUEUE_INVALID on double commit, got %i\n", result);
+        return 1;
+    }
+
+    result = queuePop(&queue, &data);
+    if (result != STATIC_QUEUE_SUCCESS || data != 10) {
+        printf("Expected 10, got %u (result: %i)\n", data, result);
+        return 1;
+    }
+    printf("Test 32 passed: Item published on commit\n");
+
+    // Test 33: Out of order commits keep reserve order
+    printf("\nTest 33: Out of order commit\n");
+    queueClear(&queue);
+
+    result = staticQueueReserveMany(&queue, reserved, LIST_LEN + 1);
+    if (result != LIST_LEN) {
+        printf("Expected to reserve %i items, got %i\n", LIST_LEN, result);
+        return 1;
+    }
+
+    result = staticQueueReserve(&queue, &item_to_erase);
+    if (result != STATIC_QUEUE_FULL) {
+        printf("Expected STATIC_QUEUE_FULL, got %i\n", result);
+        return 1;
+    }
+
+    for (int i = 0; i < LIST_LEN; i++) {
+        reserved_item = CONTAINER_OF(reserved[i], myList_t, node);
+        reserved_item->number = (i + 1) * 10;
+    }
+
+    // Commit the last items first, nothing can be pop'ed until the first is committed
+    for (int i = LIST_LEN - 1; i > 0; i--) {
+        staticQueueCommit(&queue, reserved[i]);
+    }
+
+    result = queuePop(&queue, &data);
+    if (result != STATIC_QUEUE_EMPTY) {
+        printf("Expected STATIC_QUEUE_EMPTY while first item pending, got %i\n", result);
+        return 1;
+    }
+
+    staticQueueCommit(&queue, reserved[0]);
+    for (int i = 0; i < LIST_LEN; i++) {
+        result = queuePop(&queue, &data);
+        if (result != STATIC_QUEUE_SUCCESS || data != (uint32_t)(i + 1) * 10) {
+            printf("Expected %i, got %u (result: %i)\n", (i + 1) * 10, data, result);
+            return 1;
+        }
+    }
+    printf("Test 33 passed: Reserve order preserved\n");
+
+    // Test 34: ForEach skips pending items and erase cancels a reservation
+    printf("\nTest 34: ForEach with pending items\n");
+    queueClear(&queue);
+    g_foreach_counter = 0;
+    g_foreach_sum = 0;
+
+    queuePut(&queue, 10);
+    staticQueueReserve(&queue, &reserved[0]);
+    queuePut(&queue, 30);
+
+    result = staticQueueForEach(&queue, countCallback);
+    if (result != STATIC_QUEUE_SUCCESS || g_foreach_counter != 2 || g_foreach_sum != 40) {
+        printf("Expected 2 committed items with sum 40, got %i/%i\n", g_foreach_counter, g_foreach_sum);
+        return 1;
+    }
+
+    result = staticQueueErase(&queue, reserved[0]);
+    if (result != STATIC_QUEUE_SUCCESS || staticQueueGetNumItems(&queue) != 2) {
+        printf("Expected erase of reservation to succeed, got %i\n", result);
+        return 1;
+    }
+    printf("Test 34 passed: Pending items hidden from ForEach\n");
+
+    printf("\n=== All staticQueueReserve/Commit tests passed ===\n");
+
+    // ===== Test staticQueuePopLast/PeekLast functions =====
+    printf("\n=== Testing staticQueuePopLast/PeekLast ===\n");
+
+    // Test 35: LIFO order with Put and PopLast
+    printf("\nTest 35: PopLast returns newest item first\n");
+    queueClear(&queue);
+
+    queuePut(&queue, 10);
+    queuePut(&queue, 20);
+    queuePut(&queue, 30);
+    queuePut(&queue, 40);
+
+    result = staticQueuePeekLast(&queue, &item_to_erase);
+    reserved_item = CONTAINER_OF(item_to_erase, myList_t, node);
+    if (result != STATIC_QUEUE_SUCCESS || reserved_item->number != 40) {
+        printf("Expected to peek 40 (result: %i)\n", result);
+        return 1;
+    }
+
+    for (int i = 4; i > 0; i--) {
+        result = staticQueuePopLast(&queue, &item_to_erase);
+        reserved_item = CONTAINER_OF(item_to_erase, myList_t, node);
+        if (result != STATIC_QUEUE_SUCCESS || reserved_item->number != i * 10) {
+            printf("Expected %i, got %i (result: %i)\n", i * 10, reserved_item->number, result);
+            return 1;
+        }
+    }
+
+    result = staticQueuePopLast(&queue, &item_to_erase);
+    if (result != STATIC_QUEUE_EMPTY || !staticQueueEmpty(&queue)) {
+        printf("Expected STATIC_QUEUE_EMPTY, got %i\n", result);
+        return 1;
+    }
+    printf("Test 35 passed: LIFO order\n");
+
+    // Test 36: Mixed deque operations keep capacity
+    printf("\nTest 36: Deque operations from both ends\n");
+    queueClear(&queue);
+
+    queuePut(&queue, 20);
+    queuePutFirst(&queue, 10);
+    queuePut(&queue, 30);
+    staticQueuePopLast(&queue, &item_to_erase);
+    queuePut(&queue, 40);
+    queuePut(&queue, 50);
+
+    if (!staticQueuefull(&queue)) {
+        printf("Queue should be full\n");
+        return 1;
+    }
+
+    uint32_t deque_expected[] = {10, 20, 40, 50};
+    for (int i = 0; i < 4; i++) {
+        result = queuePop(&queue, &data);
+        if (result != STATIC_QUEUE_SUCCESS || data != deque_expected[i]) {
+            printf("Expected %u, got %u (result: %i)\n", deque_expected[i], data, result);
+            return 1;
+        }
+    }
+    printf("Test 36 passed: Deque order and capacity\n");
+
+    printf("\n=== All staticQueuePopLast/PeekLast tests passed ===\n");
+
+    // ===== Test staticQueueEraseIf function =====
+    printf("\n=== Testing staticQueueEraseIf ===\n");
+
+    // Test 37: Erase matching items in one pass
+    printf("\nTest 37: EraseIf removes matching items and keeps order\n");
+    queueClear(&queue);
+
+    queuePut(&queue, 1);
+    queuePut(&queue, 2);
+    queuePut(&queue, 4);
+    queuePut(&queue, 5);
+
+    result = staticQueueEraseIf(&queue, isEvenPredicate, NULL);
+    if (result != 2 || staticQueueGetNumItems(&queue) != 2) {
+        printf("Expected 2 items erased, got %i\n", result);
+        return 1;
+    }
+
+    // The freed slots must be reusable, fill the queue again
+    queuePut(&queue, 7);
+    queuePut(&queue, 9);
+    if (!staticQueuefull(&queue)) {
+        printf("Queue should be full after refill\n");
+        return 1;
+    }
+
+    uint32_t erase_if_expected[] = {1, 5, 7, 9};
+    for (int i = 0; i < 4; i++) {
+        result = queuePop(&queue, &data);
+        if (result != STATIC_QUEUE_SUCCESS || data != erase_if_expected[i]) {
+            printf("Expected %u, got %u (result: %i)\n", erase_if_expected[i], data, result);
+            return 1;
+        }
+    }
+    printf("Test 37 passed: Matching items erased in one pass\n");
+
+    // Test 38: EraseIf on a wrapped queue, erasing everything and nothing
+    printf("\nTest 38: EraseIf edge cases\n");
+    queueClear(&queue);
+
+    queuePut(&queue, 10);
+    queuePut(&queue, 20);
+    queuePop(&queue, &data);
+    queuePut(&queue, 30);
+    queuePut(&queue, 40);
+    queuePut(&queue, 50);
+
+    int32_t limit = 0;
+    result = staticQueueEraseIf(&queue, lessThanPredicate, &limit);
+    if (result != 0 || !staticQueuefull(&queue)) {
+        printf("Expected nothing erased from full queue, got %i\n", result);
+        return 1;
+    }
+
+    limit = 35;
+    result = staticQueueEraseIf(&queue, lessThanPredicate, &limit);
+    if (result != 2 || staticQueueGetNumItems(&queue) != 2) {
+        printf("Expected 2 items erased from full queue, got %i\n", result);
+        return 1;
+    }
+
+    result = queuePeak(&queue, &data);
+    if (result != STATIC_QUEUE_SUCCESS || data != 40) {
+        printf("Expected 40 at front, got %u (result: %i)\n", data, result);
+        return 1;
+    }
+
+    limit = 100;
+    result = staticQueueEraseIf(&queue, lessThanPredicate, &limit);
+    if (result != 2 || !staticQueueEmpty(&queue)) {
+        printf("Expected queue empty after erasing all, got %i\n", result);
+        return 1;
+    }
+
+    for (int i = 0; i < LIST_LEN; i++) {
+        if (queuePut(&queue, i) != STATIC_QUEUE_SUCCESS) {
+            printf("Failed to refill queue after EraseIf\n");
+            return 1;
+        }
+    }
+    printf("Test 38 passed: EraseIf edge cases\n");
+
+    printf("\n=== All staticQueueEraseIf tests passed ===\n");
+
+    // ===== Test staticQueueForEachCtx/Find functions =====
+    printf("\n=== Testing staticQueueForEachCtx/Find ===\n");
+
+    // Test 39: ForEach with user context
+    printf("\nTest 39: ForEachCtx passes user context\n");
+    queueClear(&queue);
+
+    queuePut(&queue, 10);
+    queuePut(&queue, 20);
+    queuePut(&queue, 30);
+
+    foreachCtx_t foreach_ctx = {0};
+    result = staticQueueForEachCtx(&queue, countCtxCallback, &foreach_ctx);
+    if (result != STATIC_QUEUE_SUCCESS || foreach_ctx.counter != 3 || foreach_ctx.sum != 60) {
+        printf("Expected 3 items with sum 60, got %i/%i\n", foreach_ctx.counter, foreach_ctx.sum);
+        return 1;
+    }
+    printf("Test 39 passed: Context carried through iteration\n");
+
+    // Test 40: Find stops at the first match
+    printf("\nTest 40: Find first match\n");
+    int32_t visits = 0;
+    result = staticQueueFind(&queue, equalsPredicate, &visits, &item_to_erase);
+    reserved_item = CONTAINER_OF(item_to_erase, myList_t, node);
+    if (result != STATIC_QUEUE_SUCCESS || reserved_item->number != 20 || visits != -2) {
+        printf("Expected to find 20 after 2 visits, got %i (result: %i)\n", -visits, result);
+        return 1;
+    }
+
+    queueClear(&queue);
+    queuePut(&queue, 10);
+    result = staticQueueFind(&queue, equalsPredicate, &visits, &item_to_erase);
+    if (result != STATIC_QUEUE_NOT_IN_QUEUE) {
+        printf("Expected STATIC_QUEUE_NOT_IN_QUEUE, got %i\n", result);
+        return 1;
+    }
+
+    queueClear(&queue);
+    result = staticQueueFind(&queue, equalsPredicate, &visits, &item_to_erase);
+    if (result != STATIC_QUEUE_NOT_IN_QUEUE) {
+        printf("Expected STATIC_QUEUE_NOT_IN_QUEUE for an empty queue, got %i\n", result);
+        return 1;
+    }
+    printf("Test 40 passed: Find stops early\n");
+
+    printf("\n=== All staticQueueForEachCtx/Find tests passed ===\n");
+
+    // ===== Test staticQueueCompact function =====
+    printf("\n=== Testing staticQueueCompact ===\n");
+
+    // Test 41: Compaction restores memory order and keeps logical order
+    printf("\nTest 41: Compact after middle erases\n");
+    staticQueue_t compact_queue;
+    myList_t      compact_list[8] = {0};
+    STATIC_QUEUE_INIT(&compact_queue, compact_list, 8);
+
+    staticQueueItem_t* compact_items[8];
+    for (int i = 0; i < 8; i++) {
+        staticQueuePut(&compact_queue, &compact_items[i]);
+        reserved_item = CONTAINER_OF(compact_items[i], myList_t, node);
+        reserved_item->number = i + 1;
+    }
+
+    // Scramble the ring, logical order is now 2 4 6 7 8 9 10
+    queuePop(&compact_queue, &data);
+    staticQueueErase(&compact_queue, compact_items[2]);
+    staticQueueErase(&compact_queue, compact_items[4]);
+    queuePut(&compact_queue, 9);
+    queuePut(&compact_queue, 10);
+
+    result = staticQueueCompact(&compact_queue, swapCallback, NULL);
+    if (result < 0) {
+        printf("Compact failed %i\n", result);
+        return 1;
+    }
+
+    uint32_t compact_expected[] = {2, 4, 6, 7, 8, 9, 10};
+    for (int i = 0; i < 7; i++) {
+        if (compact_list[i].number != (int32_t)compact_expected[i] || !compact_list[i].node.active) {
+            printf("Expected %u in slot %i, got %i\n", compact_expected[i], i, compact_list[i].number);
+            return 1;
+        }
+    }
+
+    if (compact_queue.tail != &compact_list[0].node || compact_queue.head != &compact_list[7].node) {
+        printf("Expected tail at first slot and head at last slot\n");
+        return 1;
+    }
+
+    queuePut(&compact_queue, 11);
+    if (!staticQueuefull(&compact_queue)) {
+        printf("Queue should be full after compaction and refill\n");
+        return 1;
+    }
+
+    for (int i = 0; i < 7; i++) {
+        result = queuePop(&compact_queue, &data);
+        if (result != STATIC_QUEUE_SUCCESS || data != compact_expected[i]) {
+            printf("Expected %u, got %u (result: %i)\n", compact_expected[i], data, result);
+            return 1;
+        }
+    }
+    printf("Test 41 passed: Queue compacted in place\n");
+
+    // Test 42: Compaction is refused with outstanding reservations
+    printf("\nTest 42: Compact with pending reservation\n");
+    staticQueueReserve(&compact_queue, &compact_items[0]);
+    result = staticQueueCompact(&compact_queue, swapCallback, NULL);
+    if (result != STATIC_QUEUE_INVALID) {
+        printf("Expected STATIC_QUEUE_INVALID, got %i\n", result);
+        return 1;
+    }
+    printf("Test 42 passed: Pending reservation blocks compaction\n");
+
+    printf("\n=== All staticQueueCompact tests passed ===\n");
+
+    // ===== Test staticQueueSetWatermarks function =====
+    printf("\n=== Testing staticQueueSetWatermarks ===\n");
+
+    // Test 43: Callbacks fire exactly on the crossings
+    printf("\nTest 43: Watermark crossings\n");
+    queueClear(&queue);
+
+    int32_t crossings[2] = {0};
+    result = staticQueueSetWatermarks(&queue, 3, 1, watermarkCallback, crossings);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        printf("Set watermarks failed %i\n", result);
+        return 1;
+    }
+
+    queuePut(&queue, 10);
+    queuePut(&queue, 20);
+    if (crossings[1] != 0 || staticQueueAboveWatermark(&queue)) {
+        printf("High watermark fired too early\n");
+        return 1;
+    }
+
+    queuePut(&queue, 30);
+    queuePut(&queue, 40);
+    if (crossings[1] != 1 || !staticQueueAboveWatermark(&queue)) {
+        printf("Expected one high crossing, got %i\n", crossings[1]);
+        return 1;
+    }
+
+    // Falling to 2 is between the watermarks, nothing happens until 1
+    queuePop(&queue, &data);
+    queuePop(&queue, &data);
+    if (crossings[0] != 0) {
+        printf("Low watermark fired too early\n");
+        return 1;
+    }
+
+    result = staticQueuePeak(&queue, &item_to_erase);
+    staticQueueErase(&queue, item_to_erase);
+    if (crossings[0] != 1 || staticQueueAboveWatermark(&queue)) {
+        printf("Expected one low crossing on erase, got %i\n", crossings[0]);
+        return 1;
+    }
+
+    queuePut(&queue, 50);
+    queuePutFirst(&queue, 60);
+    if (crossings[1] != 2 || staticQueueGetNumItems(&queue) != 3) {
+        printf("Expected second high crossing at 3 items, got %i\n", crossings[1]);
+        return 1;
+    }
+
+    queueClear(&queue);
+    if (crossings[0] != 2 || staticQueueGetNumItems(&queue) != 0) {
+        printf("Expected clear to cross the low watermark\n");
+        return 1;
+    }
+
+    result = staticQueueSetWatermarks(&queue, 2, 2, NULL, NULL);
+    if (result != STATIC_QUEUE_INVALID) {
+        printf("Expected STATIC_QUEUE_INVALID for low >= high, got %i\n", result);
+        return 1;
+    }
+
+    // The callback may change the queue itself
+    int32_t shed = 0;
+    staticQueueSetWatermarks(&queue, 3, 1, shedCallback, &shed);
+    queuePut(&queue, 70);
+    queuePut(&queue, 80);
+    queuePut(&queue, 90);
+    result = queuePop(&queue, &data);
+    if (shed != 70 || result != STATIC_QUEUE_SUCCESS || data != 80 || staticQueueGetNumItems(&queue) != 1) {
+        printf("Expected the callback to shed 70, got %i and %u\n", shed, data);
+        return 1;
+    }
+    queueClear(&queue);
+
+    staticQueueSetWatermarks(&queue, 0, 0, NULL, NULL);
+    printf("Test 43 passed: Watermarks fire on crossings only\n");
+
+    printf("\n=== All staticQueueSetWatermarks tests passed ===\n");
+
+    // ===== Test staticQueuePutOverwrite function =====
+    printf("\n=== Testing staticQueuePutOverwrite ===\n");
+
+    // Test 44: Full queue evicts the oldest item
+    printf("\nTest 44: Overwrite oldest when full\n");
+    queueClear(&queue);
+
+    staticQueueItem_t* evicted;
+    for (int i = 1; i <= LIST_LEN + 2; i++) {
+        result = staticQueuePutOverwrite(&queue, &item_to_erase, &evicted);
+        if (result != STATIC_QUEUE_SUCCESS) {
+            printf("Put overwrite failed %i\n", result);
+            return 1;
+        }
+
+        if (i <= LIST_LEN && evicted != NULL) {
+            printf("Nothing should be evicted before the queue is full\n");
+            return 1;
+        }
+
+        if (i > LIST_LEN) {
+            reserved_item = CONTAINER_OF(evicted, myList_t, node);
+            if (evicted != item_to_erase || reserved_item->number != (i - LIST_LEN) * 10) {
+                printf("Expected to evict %i, got %i\n", (i - LIST_LEN) * 10, reserved_item->number);
+                return 1;
+            }
+        }
+
+        reserved_item = CONTAINER_OF(item_to_erase, myList_t, node);
+        reserved_item->number = i * 10;
+    }
+
+    if (staticQueueGetNumItems(&queue) != LIST_LEN) {
+        printf("Expected %i items, got %i\n", LIST_LEN, staticQueueGetNumItems(&queue));
+        return 1;
+    }
+
+    // The newest items remain, oldest first
+    for (int i = 3; i <= LIST_LEN + 2; i++) {
+        result = queuePop(&queue, &data);
+        if (result != STATIC_QUEUE_SUCCESS || data != (uint32_t)i * 10) {
+            printf("Expected %i, got %u (result: %i)\n", i * 10, data, result);
+            return 1;
+        }
+    }
+    printf("Test 44 passed: Oldest items evicted\n");
+
+    printf("\n=== All staticQueuePutOverwrite tests passed ===\n");
+
+    // ===== Test staticQueuePutAfter function =====
+    printf("\n=== Testing staticQueuePutAfter ===\n");
+
+    // Test 45: Insert in the middle, at the front and at the end
+    printf("\nTest 45: PutAfter positions\n");
+    queueClear(&queue);
+
+    staticQueueItem_t* after_first;
+    staticQueuePut(&queue, &after_first);
+    reserved_item = CONTAINER_OF(after_first, myList_t, node);
+    reserved_item->number = 10;
+    queuePut(&queue, 40);
+
+    staticQueueItem_t* after_middle;
+    result = staticQueuePutAfter(&queue, after_first, &after_middle);
+    reserved_item = CONTAINER_OF(after_middle, myList_t, node);
+    reserved_item->number = 20;
+    if (result != STATIC_QUEUE_SUCCESS) {
+        printf("PutAfter failed %i\n", result);
+        return 1;
+    }
+
+    // Takes the last free item, the queue is full after this
+    result = staticQueuePutAfter(&queue, after_middle, &item_to_erase);
+    reserved_item = CONTAINER_OF(item_to_erase, myList_t, node);
+    reserved_item->number = 30;
+    if (result != STATIC_QUEUE_SUCCESS || !staticQueuefull(&queue)) {
+        printf("Expected full queue after PutAfter, got %i\n", result);
+        return 1;
+    }
+
+    result = staticQueuePutAfter(&queue, after_first, &item_to_erase);
+    if (result != STATIC_QUEUE_FULL) {
+        printf("Expected STATIC_QUEUE_FULL, got %i\n", result);
+        return 1;
+    }
+
+    for (int i = 1; i <= 4; i++) {
+        result = queuePop(&queue, &data);
+        if (result != STATIC_QUEUE_SUCCESS || data != (uint32_t)i * 10) {
+            printf("Expected %i, got %u (result: %i)\n", i * 10, data, result);
+            return 1;
+        }
+    }
+
+    result = staticQueuePutAfter(&queue, NULL, &item_to_erase);
+    if (result != STATIC_QUEUE_SUCCESS || staticQueueGetNumItems(&queue) != 1) {
+        printf("Expected PutAfter NULL to put first, got %i\n", result);
+        return 1;
+    }
+    printf("Test 45 passed: PutAfter keeps order and capacity\n");
+
+    printf("\n=== All staticQueuePutAfter tests passed ===\n");
+
+    // ===== Test staticQueueMoveLast function =====
+    printf("\n=== Testing staticQueueMoveLast ===\n");
+
+    // Test 46: Move the oldest and a middle item in a full queue, then the oldest in a partial queue
+    printf("\nTest 46: MoveLast in full and partial queues\n");
+    queueClear(&queue);
+
+    staticQueueItem_t* move_items[4];
+    for (int i = 0; i < 4; i++) {
+        staticQueuePut(&queue, &move_items[i]);
+        reserved_item = CONTAINER_OF(move_items[i], myList_t, node);
+        reserved_item->number = i + 1;
+    }
+
+    // 1 2 3 4 -> 2 3 4 1 -> 2 4 1 3
+    result = staticQueueMoveLast(&queue, move_items[0]);
+    result |= staticQueueMoveLast(&queue, move_items[2]);
+    if (result != STATIC_QUEUE_SUCCESS || !staticQueuefull(&queue)) {
+        printf("MoveLast in full queue failed %i\n", result);
+        return 1;
+    }
+
+    // 4 1 3 -> 1 3 4 -> 1 3 4 5
+    queuePop(&queue, &data);
+    staticQueueMoveLast(&queue, move_items[3]);
+    queuePut(&queue, 5);
+
+    uint32_t move_expected[] = {1, 3, 4, 5};
+    for (int i = 0; i < 4; i++) {
+        result = queuePop(&queue, &data);
+        if (result != STATIC_QUEUE_SUCCESS || data != move_expected[i]) {
+            printf("Expected %u, got %u (result: %i)\n", move_expected[i], data, result);
+            return 1;
+        }
+    }
+
+    result = staticQueueMoveLast(&queue, move_items[0]);
+    if (result != STATIC_QUEUE_NOT_IN_QUEUE) {
+        printf("Expected STATIC_QUEUE_NOT_IN_QUEUE, got %i\n", result);
+        return 1;
+    }
+    printf("Test 46 passed: MoveLast relinks in O(1)\n");
+
+    printf("\n=== All staticQueueMoveLast tests passed ===\n");
+
+    // ===== Test value API =====
+    printf("\n=== Testing staticQueuePush/staticQueueTake ===\n");
+
+    // Test 47: Push and take payloads by value, single and bulk, across the ring wrap
+    printf("\nTest 47: Push and take by value\n");
+    staticQueue_t msg_queue;
+    myMsgItem_t   msg_list[8] = {0};
+    myMsg_t       msgs_in[10];
+    myMsg_t       msgs_out[16];
+    STATIC_QUEUE_INIT(&msg_queue, msg_list, 8);
+
+    if (staticQueuePush(&msg_queue, &msgs_in[0]) != STATIC_QUEUE_INVALID) {
+        printf("Expected STATIC_QUEUE_INVALID without a payload\n");
+        return 1;
+    }
+    STATIC_QUEUE_SET_PAYLOAD(&msg_queue, myMsgItem_t, msg);
+
+    for (uint64_t i = 0; i < 10; i++) {
+        msgs_in[i].id    = i;
+        msgs_in[i].value = i * 100;
+    }
+
+    result = staticQueuePushMany(&msg_queue, msgs_in, 10);
+    if (result != 8 || staticQueuePush(&msg_queue, &msgs_in[8]) != STATIC_QUEUE_FULL) {
+        printf("Expected 8 pushed and a full queue, got %i\n", result);
+        return 1;
+    }
+
+    result = staticQueueTake(&msg_queue, &msgs_out[0]);
+    if (result != STATIC_QUEUE_SUCCESS || msgs_out[0].id != 0 || msgs_out[0].value != 0) {
+        printf("Expected message 0, got %lu (result: %i)\n", (unsigned long)msgs_out[0].id, result);
+        return 1;
+    }
+
+    // Wrap: push the last two behind the remaining seven, then take everything
+    staticQueuePush(&msg_queue, &msgs_in[8]);
+    result = staticQueueTakeMany(&msg_queue, msgs_out, 16);
+    if (result != 8 || staticQueueTake(&msg_queue, &msgs_out[0]) != STATIC_QUEUE_EMPTY) {
+        printf("Expected 8 taken and an empty queue, got %i\n", result);
+        return 1;
+    }
+
+    for (uint64_t i = 0; i < 8; i++) {
+        if (msgs_out[i].id != i + 1 || msgs_out[i].value != (i + 1) * 100) {
+            printf("Expected message %lu, got %lu\n", (unsigned long)(i + 1), (unsigned long)msgs_out[i].id);
+            return 1;
+        }
+    }
+    printf("Test 47 passed: Payloads copied in and out in order\n");
+
+    printf("\n=== All value API tests passed ===\n");
+
+    // ===== Test TTL expiry =====
+    printf("\n=== Testing staticQueueExpire ===\n");
+
+    // Test 48: Expire stops at the first live item, with and without the batch return
+    printf("\nTest 48: Expire items older than the ttl\n");
+    staticQueue_t      stamped_queue;
+    stampedItem_t      stamped_list[8] = {0};
+    staticQueueItem_t* expired_items[8];
+    staticQueueItem_t* stamped_item;
+    STATIC_QUEUE_INIT(&stamped_queue, stamped_list, 8);
+
+    if (staticQueueExpire(&stamped_queue, 0, 10, NULL, 8) != STATIC_QUEUE_INVALID) {
+        printf("Expected STATIC_QUEUE_INVALID without timestamps\n");
+        return 1;
+    }
+    STATIC_QUEUE_SET_TIMESTAMP(&stamped_queue, stampedItem_t, put_time, testClock, NULL);
+
+    // Put at 0, 10, 20 and 30
+    for (int32_t i = 0; i < 4; i++) {
+        g_now = i * 10;
+        staticQueuePut(&stamped_queue, &stamped_item);
+        stampedItem_t* stamped_entry = CONTAINER_OF(stamped_item, stampedItem_t, node);
+        stamped_entry->number        = i;
+    }
+
+    result = staticQueueExpire(&stamped_queue, 25, 10, expired_items, 8);
+    stampedItem_t* first_expired  = CONTAINER_OF(expired_items[0], stampedItem_t, node);
+    stampedItem_t* second_expired = CONTAINER_OF(expired_items[1], stampedItem_t, node);
+    if (result != 2 || first_expired->number != 0 || second_expired->number != 1) {
+        printf("Expected items 0 and 1 to expire, got %i\n", result);
+        return 1;
+    }
+
+    // Both remaining items have expired at 100, max_items leaves one
+    result = staticQueueExpire(&stamped_queue, 100, 10, NULL, 1);
+    if (result != 1 || staticQueueGetNumItems(&stamped_queue) != 1) {
+        printf("Expected one item to expire and one left, got %i\n", result);
+        return 1;
+    }
+
+    // A fresh item at the front hides the expired one behind it
+    g_now = 100;
+    staticQueuePutFirst(&stamped_queue, &stamped_item);
+    result = staticQueueExpire(&stamped_queue, 105, 10, NULL, 8);
+    if (result != 0 || staticQueueGetNumItems(&stamped_queue) != 2) {
+        printf("Expected nothing to expire, got %i\n", result);
+        return 1;
+    }
+
+    result = staticQueueExpire(&stamped_queue, 110, 10, expired_items, 8);
+    stampedItem_t* last_expired = CONTAINER_OF(expired_items[1], stampedItem_t, node);
+    if (result != 2 || last_expired->number != 3 || !staticQueueEmpty(&stamped_queue)) {
+        printf("Expected the last two items to expire, got %i\n", result);
+        return 1;
+    }
+
+    // An item stamped after now, by a clock read on another thread, is not expired
+    g_now = 200;
+    staticQueuePut(&stamped_queue, &stamped_item);
+    result = staticQueueExpire(&stamped_queue, 150, 10, NULL, 8);
+    if (result != 0 || staticQueueGetNumItems(&stamped_queue) != 1) {
+        printf("Expected an item from the future to stay, got %i\n", result);
+        return 1;
+    }
+    staticQueuePop(&stamped_queue, &stamped_item);
+    printf("Test 48 passed: Only the expired front items are removed\n");
+
+    printf("\n=== All staticQueueExpire tests passed ===\n");
+
+#if STATIC_QUEUE_TRACE
+    // ===== Test trace record and replay =====
+    printf("\n=== Testing staticQueueTraceStart/staticQueueTraceReplay ===\n");
+
+    // Test 49: Record a mixed workload, starting mid ring, and replay it on a second queue
+    printf("\nTest 49: Record and replay a trace\n");
+    staticQueue_t      traced_queue;
+    staticQueue_t      replay_queue;
+    myList_t           traced_list[8] = {0};
+    myList_t           replay_list[8] = {0};
+    staticQueueTrace_t trace;
+    uint32_t           records[64];
+    staticQueueItem_t* trace_item;
+    STATIC_QUEUE_INIT(&traced_queue, traced_list, 8);
+    STATIC_QUEUE_INIT(&replay_queue, replay_list, 8);
+
+    queuePut(&traced_queue, 99);
+    queuePop(&traced_queue, &data);
+    result = staticQueueTraceStart(&traced_queue, &trace, records, 64);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        printf("Expected STATIC_QUEUE_SUCCESS, got %i\n", result);
+        return 1;
+    }
+
+    // 1 2 3 4 5 6 -> 0 1 2 3 4 5 6 -> 1 2 3 4 5 -> 1 3 4 5 -> 3 4 5 1 -> 3 4 5 1 10 -> 3 5 1
+    for (uint32_t i = 1; i <= 6; i++) {
+        queuePut(&traced_queue, i);
+    }
+    queuePutFirst(&traced_queue, 0);
+    queuePop(&traced_queue, &data);
+    staticQueuePopLast(&traced_queue, &trace_item);
+    staticQueuePeak(&traced_queue, &trace_item);
+    staticQueueErase(&traced_queue, trace_item->next);
+    staticQueueMoveLast(&traced_queue, trace_item);
+    queuePut(&traced_queue, 10);
+    staticQueueForEach(&traced_queue, eraseEvenCallback);
+    g_foreach_counter = 0;
+    staticQueueForEach(&traced_queue, stopCallback);
+    staticQueueTraceStop(&traced_queue);
+
+    foreachCtx_t replay_ctx = {0, 0};
+    result = staticQueueTraceReplay(&replay_queue, records, trace.num_records, countCtxCallback, &replay_ctx);
+    if (result != (int32_t)trace.num_records || trace.dropped != 0 || trace.unsupported != 0) {
+        printf("Expected %u records replayed, got %i\n", trace.num_records, result);
+        return 1;
+    }
+
+    // Puts and pops return 10 items, the first ForEach visits 5 and the second stops on the 2nd
+    if (replay_ctx.counter != 17) {
+        printf("Expected 17 visits, got %i\n", replay_ctx.counter);
+        return 1;
+    }
+
+    // Same slots in the same order, the replay queue never saw the numbers
+    while (staticQueuePop(&traced_queue, &trace_item) == STATIC_QUEUE_SUCCESS) {
+        staticQueueItem_t* replay_item;
+        myList_t*          traced_entry = CONTAINER_OF(trace_item, myList_t, node);
+        if (staticQueuePop(&replay_queue, &replay_item) != STATIC_QUEUE_SUCCESS) {
+            printf("Replay queue ran out of items\n");
+            return 1;
+        }
+        myList_t* replay_entry = CONTAINER_OF(replay_item, myList_t, node);
+        if (traced_entry - traced_list != replay_entry - replay_list) {
+            printf("Expected slot %i, got %i\n", (int)(traced_entry - traced_list), (int)(replay_entry - replay_list));
+            return 1;
+        }
+    }
+    if (!staticQueueEmpty(&replay_queue)) {
+        printf("Expected the replay queue to be empty\n");
+        return 1;
+    }
+
+    // The ring is out of array order now, a replay could not start from it
+    result = staticQueueTraceStart(&traced_queue, &trace, records, 64);
+    if (result != STATIC_QUEUE_INVALID) {
+        printf("Expected STATIC_QUEUE_INVALID, got %i\n", result);
+        return 1;
+    }
+
+    // Reserve is only counted, and a full buffer drops
+    STATIC_QUEUE_INIT(&traced_queue, traced_list, 8);
+    staticQueueTraceStart(&traced_queue, &trace, records, 2);
+    staticQueueReserve(&traced_queue, &trace_item);
+    staticQueueCommit(&traced_queue, trace_item);
+    queuePut(&traced_queue, 1);
+    queuePut(&traced_queue, 2);
+    if (trace.num_records != 2 || trace.dropped != 1 || trace.unsupported != 1) {
+        printf("Expected 2 records, 1 dropped and 1 unsupported, got %u %u %u\n",
+               trace.num_records, trace.dropped, trace.unsupported);
+        return 1;
+    }
+    printf("Test 49 passed: Trace replays to the same queue state\n");
+
+    printf("\n=== All trace tests passed ===\n");
+#endif
+
+#if STATIC_QUEUE_SEQLOCK
+    // ===== Test concurrent readers =====
+    printf("\n=== Testing staticQueueSnapshot/staticQueuePeekCopy ===\n");
+
+    // Test 50: Snapshots and front copies, first in step with the writer and then concurrently
+    printf("\nTest 50: Snapshot and peek copy beside a running writer\n");
+    staticQueueSnapshot_t seqlock_snapshot;
+    staticQueueItem_t*    seqlock_item;
+    myMsg_t               seqlock_msg = {1, 100};
+    STATIC_QUEUE_INIT(&g_seqlock_queue, g_seqlock_list, SEQLOCK_LIST_LEN);
+    STATIC_QUEUE_SET_PAYLOAD(&g_seqlock_queue, myMsgItem_t, msg);
+
+    staticQueueSnapshot(&g_seqlock_queue, &seqlock_snapshot);
+    uint32_t start_version = seqlock_snapshot.version;
+    staticQueuePush(&g_seqlock_queue, &seqlock_msg);
+    staticQueueSnapshot(&g_seqlock_queue, &seqlock_snapshot);
+    if (seqlock_snapshot.version != start_version + 2 || seqlock_snapshot.num_items != 1 ||
+        seqlock_snapshot.tail != &g_seqlock_list[0].node || seqlock_snapshot.head != &g_seqlock_list[1].node) {
+        printf("Expected one item and the version two steps on, got %u items\n", seqlock_snapshot.num_items);
+        return 1;
+    }
+
+    seqlock_msg.id = 0;
+    result = staticQueuePeekCopy(&g_seqlock_queue, &seqlock_msg);
+    if (result != STATIC_QUEUE_SUCCESS || seqlock_msg.id != 1 || seqlock_msg.value != 100) {
+        printf("Expected message 1, got %lu (result: %i)\n", (unsigned long)seqlock_msg.id, result);
+        return 1;
+    }
+
+    // A reserved front item is not visible until it is committed
+    staticQueueTake(&g_seqlock_queue, &seqlock_msg);
+    staticQueueReserve(&g_seqlock_queue, &seqlock_item);
+    if (staticQueuePeekCopy(&g_seqlock_queue, &seqlock_msg) != STATIC_QUEUE_EMPTY) {
+        printf("Expected STATIC_QUEUE_EMPTY for a reserved item\n");
+        return 1;
+    }
+    myMsgItem_t* reserved_msg = CONTAINER_OF(seqlock_item, myMsgItem_t, node);
+    reserved_msg->msg.id      = 2;
+    reserved_msg->msg.value   = 200;
+    staticQueueCommit(&g_seqlock_queue, seqlock_item);
+    result = staticQueuePeekCopy(&g_seqlock_queue, &seqlock_msg);
+    if (result != STATIC_QUEUE_SUCCESS || seqlock_msg.id != 2) {
+        printf("Expected message 2, got %lu (result: %i)\n", (unsigned long)seqlock_msg.id, result);
+        return 1;
+    }
+    staticQueueTake(&g_seqlock_queue, &seqlock_msg);
+
+    pthread_t reader;
+    pthread_create(&reader, NULL, seqlockReader, NULL);
+    for (uint64_t i = 0; i < 100000 || __atomic_load_n(&g_seqlock_reads, __ATOMIC_RELAXED) < 1000; i++) {
+        seqlock_msg.id    = i;
+        seqlock_msg.value = i * 100;
+        if (i % 3 == 2 || staticQueuePush(&g_seqlock_queue, &seqlock_msg) == STATIC_QUEUE_FULL) {
+            staticQueueTake(&g_seqlock_queue, &seqlock_msg);
+        }
+    }
+    __atomic_store_n(&g_seqlock_done, true, __ATOMIC_RELEASE);
+    pthread_join(reader, NULL);
+
+    if (g_seqlock_errors != 0) {
+        printf("Expected consistent reads, got %u errors in %u reads\n", g_seqlock_errors, g_seqlock_reads);
+        return 1;
+    }
+    printf("Test 50 passed: %u consistent reads beside the writer\n", g_seqlock_reads);
+
+    printf("\n=== All concurrent reader tests passed ===\n");
+#endif
+
+    // ===== Test random access =====
+    printf("\n=== Testing staticQueueAt/staticQueuePeekN ===\n");
+
+    // Test 51: Positions across the ring wrap, before and after a middle erase, and after compaction
+    printf("\nTest 51: Random access and windowed peek\n");
+    staticQueue_t      at_queue;
+    myList_t           at_list[8] = {0};
+    staticQueueItem_t* at_items[8];
+    staticQueueItem_t* at_item;
+    STATIC_QUEUE_INIT(&at_queue, at_list, 8);
+
+    // 2 3 4 5 6 7 8 9, with the front in slot 2
+    for (uint32_t i = 0; i < 6; i++) {
+        queuePut(&at_queue, i);
+    }
+    queuePop(&at_queue, &data);
+    queuePop(&at_queue, &data);
+    for (uint32_t i = 6; i < 10; i++) {
+        queuePut(&at_queue, i);
+    }
+
+    for (uint32_t k = 0; k < 8; k++) {
+        result = staticQueueAt(&at_queue, k, &at_item);
+        myList_t* at_entry = CONTAINER_OF(at_item, myList_t, node);
+        if (result != STATIC_QUEUE_SUCCESS || at_entry->number != (int32_t)k + 2) {
+            printf("Expected %u at %u, got %i (result: %i)\n", k + 2, k, at_entry->number, result);
+            return 1;
+        }
+    }
+
+    if (staticQueueAt(&at_queue, 8, &at_item) != STATIC_QUEUE_NOT_IN_QUEUE) {
+        printf("Expected STATIC_QUEUE_NOT_IN_QUEUE past the last item\n");
+        return 1;
+    }
+
+    result = staticQueuePeekN(&at_queue, at_items, 5);
+    myList_t* fifth_entry = CONTAINER_OF(at_items[4], myList_t, node);
+    if (result != 5 || fifth_entry->number != 6) {
+        printf("Expected 5 items ending with 6, got %i\n", result);
+        return 1;
+    }
+
+    // Erase 5, the walk from either end must agree: 2 3 4 6 7 8 9
+    staticQueueAt(&at_queue, 3, &at_item);
+    staticQueueErase(&at_queue, at_item);
+    uint32_t at_expected[] = {2, 3, 4, 6, 7, 8, 9};
+    for (int pass = 0; pass < 2; pass++) {
+        for (uint32_t k = 0; k < 7; k++) {
+            result = staticQueueAt(&at_queue, k, &at_item);
+            myList_t* at_entry = CONTAINER_OF(at_item, myList_t, node);
+            if (result != STATIC_QUEUE_SUCCESS || at_entry->number != (int32_t)at_expected[k]) {
+                printf("Expected %u at %u, got %i (result: %i)\n", at_expected[k], k, at_entry->number, result);
+                return 1;
+            }
+        }
+        // Second pass in array order again
+        staticQueueCompact(&at_queue, swapCallback, NULL);
+    }
+
+    // A reserved last item is counted but not returned
+    staticQueueReserve(&at_queue, &at_item);
+    result = staticQueuePeekN(&at_queue, at_items, 8);
+    if (result != 7 || staticQueueAt(&at_queue, 7, &at_item) != STATIC_QUEUE_EMPTY) {
+        printf("Expected 7 visible items and a reserved 8th, got %i\n", result);
+        return 1;
+    }
+
+    staticQueueClear(&at_queue);
+    if (staticQueuePeekN(&at_queue, at_items, 8) != STATIC_QUEUE_EMPTY) {
+        printf("Expected STATIC_QUEUE_EMPTY for an empty queue\n");
+        return 1;
+    }
+    printf("Test 51 passed: Items found by position in order and scrambled rings\n");
+
+    printf("\n=== All staticQueueAt tests passed ===\n");
+
     // Connect first driver and app
     printf("\nTest Done\n");
 }
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include "static_queue_drr.h"
+#include <stdio.h>
+
+typedef struct {
+    uint32_t size;
+    staticQueueItem_t node;
+} myPacket_t;
+
+#define NUM_FLOWS 3
+#define FLOW_LEN  64
+
+static uint32_t packetCost(staticQueueItem_t* item, void* ctx)
+{
+    (void)ctx;  // Unused
+    myPacket_t* packet = CONTAINER_OF(item, myPacket_t, node);
+    return packet->size;
+}
+
+static int32_t drrPut(staticQueueDrr_t* drr, staticQueueDrrFlow_t* flow, uint32_t size)
+{
+    staticQueueItem_t* item;
+    int32_t            result = staticQueueDrrPut(drr, flow, &item);
+
+    if (result == STATIC_QUEUE_SUCCESS) {
+        myPacket_t* packet = CONTAINER_OF(item, myPacket_t, node);
+        packet->size = size;
+    }
+
+    return result;
+}
+
+int main() {
+
+    staticQueue_t        queues[NUM_FLOWS];
+    myPacket_t           lists[NUM_FLOWS][FLOW_LEN] = {0};
+    staticQueueDrrFlow_t flows[NUM_FLOWS];
+    staticQueueDrr_t     drr;
+    staticQueueItem_t*   item;
+    staticQueueDrrFlow_t* flow;
+    int32_t              result;
+
+    for (int i = 0; i < NUM_FLOWS; i++) {
+        STATIC_QUEUE_INIT(&queues[i], lists[i], FLOW_LEN);
+    }
+
+    // Test 1: Weighted round robin with unit cost
+    printf("\nTest 1: Weights with unit cost\n");
+    staticQueueDrrInit(&drr, NULL, NULL);
+    staticQueueDrrAddFlow(&drr, &flows[0], &queues[0], 1);
+    staticQueueDrrAddFlow(&drr, &flows[1], &queues[1], 2);
+    staticQueueDrrAddFlow(&drr, &flows[2], &queues[2], 1);
+
+    if (!staticQueueDrrEmpty(&drr)) {
+        printf("Scheduler should be empty\n");
+        return 1;
+    }
+
+    for (int i = 0; i < 30; i++) {
+        drrPut(&drr, &flows[0], 1);
+        drrPut(&drr, &flows[1], 1);
+    }
+
+    // Flow 2 is empty and must never be selected
+    uint32_t served[NUM_FLOWS] = {0};
+    for (int i = 0; i < 30; i++) {
+        result = staticQueueDrrPop(&drr, &item, &flow);
+        if (result != STATIC_QUEUE_SUCCESS) {
+            printf("Pop failed %i\n", result);
+            return 1;
+        }
+        served[flow - flows]++;
+    }
+
+    if (served[0] != 10 || served[1] != 20 || served[2] != 0) {
+        printf("Expected 10/20/0 served, got %u/%u/%u\n", served[0], served[1], served[2]);
+        return 1;
+    }
+    printf("Test 1 passed: Share follows weights\n");
+
+    // Test 2: Drain, flows leave the active list when empty
+    printf("\nTest 2: Drain all flows\n");
+    uint32_t drained = 0;
+    while (staticQueueDrrPop(&drr, &item, &flow) == STATIC_QUEUE_SUCCESS) {
+        drained++;
+    }
+
+    if (drained != 30 || !staticQueueDrrEmpty(&drr)) {
+        printf("Expected 30 drained and empty scheduler, got %u\n", drained);
+        return 1;
+    }
+    printf("Test 2 passed: All flows drained\n");
+
+    // Test 3: Cost weighted fairness, big packets against small packets
+    printf("\nTest 3: Cost weighted shares\n");
+    staticQueueDrrInit(&drr, packetCost, NULL);
+    staticQueueDrrAddFlow(&drr, &flows[0], &queues[0], 500);
+    staticQueueDrrAddFlow(&drr, &flows[1], &queues[1], 500);
+    staticQueueDrrAddFlow(&drr, &flows[2], &queues[2], 500);
+
+    for (int i = 0; i < 60; i++) {
+        drrPut(&drr, &flows[0], 1000);
+        drrPut(&drr, &flows[1], 100);
+    }
+
+    uint32_t bytes[NUM_FLOWS] = {0};
+    for (int i = 0; i < 44; i++) {
+        staticQueueDrrPop(&drr, &item, &flow);
+        bytes[flow - flows] += packetCost(item, NULL);
+    }
+
+    // 8 rounds of 500 bytes each, flow 0 sends a 1000 byte packet every second round
+    if (bytes[0] != 4000 || bytes[1] != 4000) {
+        printf("Expected equal bytes served, got %u/%u\n", bytes[0], bytes[1]);
+        return 1;
+    }
+    printf("Test 3 passed: Byte shares equal\n");
+
+    // Test 4: Erase the last item of a flow removes it from the round
+    printf("\nTest 4: Erase empties flow\n");
+    staticQueueDrrInit(&drr, NULL, NULL);
+    for (int i = 0; i < NUM_FLOWS; i++) {
+        staticQueueClear(&queues[i]);
+        staticQueueDrrAddFlow(&drr, &flows[i], &queues[i], 1);
+    }
+
+    staticQueueItem_t* erase_item;
+    staticQueueDrrPut(&drr, &flows[1], &erase_item);
+    drrPut(&drr, &flows[2], 1);
+
+    result = staticQueueDrrErase(&drr, &flows[1], erase_item);
+    if (result != STATIC_QUEUE_SUCCESS || flows[1].active) {
+        printf("Expected flow 1 to leave the active list (result: %i)\n", result);
+        return 1;
+    }
+
+    result = staticQueueDrrPop(&drr, &item, &flow);
+    if (result != STATIC_QUEUE_SUCCESS || flow != &flows[2] || !staticQueueDrrEmpty(&drr)) {
+        printf("Expected pop from flow 2 (result: %i)\n", result);
+        return 1;
+    }
+    printf("Test 4 passed: Erase keeps the active list in sync\n");
+
+    // Test 5: A reserved front item passes the flow over without taking it out of the round
+    printf("\nTest 5: Reserved front item\n");
+    staticQueueItem_t* reserved_item;
+    staticQueueReserve(&queues[0], &reserved_item);
+    drrPut(&drr, &flows[0], 1);
+    drrPut(&drr, &flows[1], 1);
+
+    result = staticQueueDrrPop(&drr, &item, &flow);
+    if (result != STATIC_QUEUE_SUCCESS || flow != &flows[1]) {
+        printf("Expected pop from flow 1 (result: %i)\n", result);
+        return 1;
+    }
+
+    result = staticQueueDrrPop(&drr, &item, &flow);
+    if (result != STATIC_QUEUE_EMPTY || !flows[0].active || staticQueueDrrEmpty(&drr)) {
+        printf("Expected STATIC_QUEUE_EMPTY with flow 0 still active (result: %i)\n", result);
+        return 1;
+    }
+
+    myPacket_t* reserved_packet = CONTAINER_OF(reserved_item, myPacket_t, node);
+    reserved_packet->size       = 1;
+    staticQueueCommit(&queues[0], reserved_item);
+    for (int i = 0; i < 2; i++) {
+        result = staticQueueDrrPop(&drr, &item, &flow);
+        if (result != STATIC_QUEUE_SUCCESS || flow != &flows[0] || (i == 0 && item != reserved_item)) {
+            printf("Expected the committed item and then the next one from flow 0 (result: %i)\n", result);
+            return 1;
+        }
+    }
+    if (!staticQueueDrrEmpty(&drr)) {
+        printf("Expected all flows drained\n");
+        return 1;
+    }
+    printf("Test 5 passed: Reserved items hold their flow in the round\n");
+
+    printf("\nTest Done\n");
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include "static_queue_iov.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+typedef struct {
+    uint32_t          len;
+    char              data[16];
+    staticQueueItem_t node;
+} myMsg_t;
+
+#define QUEUE_LEN 8
+
+static void dataIov(staticQueue_t* queue, staticQueueItem_t* item, struct iovec* iov, void* ctx)
+{
+    (void)queue;
+    (void)ctx;
+    myMsg_t* msg = CONTAINER_OF(item, myMsg_t, node);
+    iov->iov_base = msg->data;
+    iov->iov_len  = msg->len;
+}
+
+static void bufferIov(staticQueue_t* queue, staticQueueItem_t* item, struct iovec* iov, void* ctx)
+{
+    (void)queue;
+    (void)ctx;
+    myMsg_t* msg = CONTAINER_OF(item, myMsg_t, node);
+    iov->iov_base = msg->data;
+    iov->iov_len  = sizeof(msg->data);
+}
+
+static void setLen(staticQueue_t* queue, staticQueueItem_t* item, size_t len, void* ctx)
+{
+    (void)queue;
+    (void)ctx;
+    myMsg_t* msg = CONTAINER_OF(item, myMsg_t, node);
+    msg->len = (uint32_t)len;
+}
+
+static void msgPut(staticQueue_t* queue, const char* text)
+{
+    staticQueueItem_t* item;
+    staticQueuePut(queue, &item);
+    myMsg_t* msg = CONTAINER_OF(item, myMsg_t, node);
+    msg->len = (uint32_t)strlen(text);
+    memcpy(msg->data, text, msg->len);
+}
+
+int main() {
+
+    staticQueue_t          out_queue;
+    staticQueue_t          in_queue;
+    myMsg_t                out_list[QUEUE_LEN] = {0};
+    myMsg_t                in_list[QUEUE_LEN]  = {0};
+    staticQueueIovWriter_t writer;
+    struct iovec           iov[QUEUE_LEN];
+    staticQueueItem_t*     item;
+    size_t                 num_bytes;
+    int                    fds[2];
+
+    STATIC_QUEUE_INIT(&out_queue, out_list, QUEUE_LEN);
+    STATIC_QUEUE_INIT(&in_queue, in_list, QUEUE_LEN);
+    staticQueueIovWriterInit(&writer, &out_queue, dataIov, NULL);
+    if (pipe(fds) != 0) {
+        printf("pipe failed\n");
+        return 1;
+    }
+
+    // Test 1: One writev for all items, one readv scatters the stream into full buffers
+    printf("\nTest 1: Writev and readv through a pipe\n");
+    const char* texts[] = {"hello", "vectored world", "0123456789abcdef", "abc", "xyzzy12"};
+    char        expected[64] = {0};
+    for (int i = 0; i < 5; i++) {
+        msgPut(&out_queue, texts[i]);
+        strcat(expected, texts[i]);
+    }
+
+    int32_t result = staticQueueWritev(&writer, fds[1], iov, QUEUE_LEN, &num_bytes);
+    if (result != STATIC_QUEUE_SUCCESS || num_bytes != strlen(expected) || !staticQueueEmpty(&out_queue)) {
+        printf("Expected %zu bytes written, got %zu (result: %i)\n", strlen(expected), num_bytes, result);
+        return 1;
+    }
+
+    result = staticQueueReadv(&in_queue, fds[0], iov, QUEUE_LEN, bufferIov, setLen, NULL, &num_bytes);
+    if (result != STATIC_QUEUE_SUCCESS || num_bytes != strlen(expected) || staticQueueGetNumItems(&in_queue) != 3) {
+        printf("Expected %zu bytes in 3 items, got %zu in %i (result: %i)\n",
+               strlen(expected), num_bytes, staticQueueGetNumItems(&in_queue), result);
+        return 1;
+    }
+
+    char received[64] = {0};
+    while (staticQueuePop(&in_queue, &item) == STATIC_QUEUE_SUCCESS) {
+        myMsg_t* msg = CONTAINER_OF(item, myMsg_t, node);
+        strncat(received, msg->data, msg->len);
+    }
+    if (strcmp(received, expected) != 0) {
+        printf("Expected \"%s\", got \"%s\"\n", expected, received);
+        return 1;
+    }
+    printf("Test 1 passed: Batch written and read back\n");
+
+    // Test 2: A partial write pops only the fully written items and resumes mid item
+    printf("\nTest 2: Partial write\n");
+    msgPut(&out_queue, "aaaaaaaaaa");
+    msgPut(&out_queue, "bbbbbbbbbb");
+    msgPut(&out_queue, "cccccccccc");
+
+    int32_t num_iov = staticQueueIovGather(&writer, iov, QUEUE_LEN);
+    result          = staticQueueIovConsume(&writer, iov, num_iov, 15);
+    if (num_iov != 3 || result != 1 || writer.offset != 5) {
+        printf("Expected 1 item pop'ed and offset 5, got %i and %zu\n", result, writer.offset);
+        return 1;
+    }
+
+    num_iov = staticQueueIovGather(&writer, iov, QUEUE_LEN);
+    if (num_iov != 2 || iov[0].iov_len != 5 || *(char*)iov[0].iov_base != 'b') {
+        printf("Expected the rest of the second item first, got %zu bytes\n", iov[0].iov_len);
+        return 1;
+    }
+
+    result = staticQueueIovConsume(&writer, iov, num_iov, 5);
+    if (result != 1 || writer.offset != 0 || staticQueueGetNumItems(&out_queue) != 1) {
+        printf("Expected the second item pop'ed, got %i\n", result);
+        return 1;
+    }
+    staticQueueClear(&out_queue);
+    printf("Test 2 passed: Partial write resumed\n");
+
+    // Test 3: A write that the kernel rejects leaves the queue as it was
+    printf("\nTest 3: Write to a full non-blocking pipe\n");
+    fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+    char filler[4096] = {0};
+    while (write(fds[1], filler, sizeof(filler)) > 0) {
+    }
+
+    msgPut(&out_queue, "blocked");
+    result = staticQueueWritev(&writer, fds[1], iov, QUEUE_LEN, &num_bytes);
+    if (result != STATIC_QUEUE_IO_ERROR || (errno != EAGAIN && errno != EWOULDBLOCK) ||
+        staticQueueGetNumItems(&out_queue) != 1) {
+        printf("Expected STATIC_QUEUE_IO_ERROR with EAGAIN, got %i\n", result);
+        return 1;
+    }
+    printf("Test 3 passed: Rejected write keeps the items\n");
+
+    close(fds[0]);
+    close(fds[1]);
+
+    printf("\nTest Done\n");
+    return 0;
+}
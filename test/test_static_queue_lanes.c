@@ -0,0 +1,121 @@
+#include "static_queue_lanes.h"
+#include <stdio.h>
+
+typedef struct {
+    int32_t number;
+    staticQueueItem_t node;
+} myList_t;
+
+#define NUM_LANES 32
+#define LANE_LEN  4
+
+static int32_t lanesPut(staticQueueLanes_t* lanes, uint32_t lane, int32_t data)
+{
+    staticQueueItem_t* item;
+    int32_t            result = staticQueueLanesPut(lanes, lane, &item);
+
+    if (result == STATIC_QUEUE_SUCCESS) {
+        myList_t* next = CONTAINER_OF(item, myList_t, node);
+        next->number = data;
+    }
+
+    return result;
+}
+
+static int32_t lanesPop(staticQueueLanes_t* lanes, int32_t* data, uint32_t* lane)
+{
+    staticQueueItem_t* item;
+    int32_t            result = staticQueueLanesPop(lanes, &item, lane);
+
+    if (result == STATIC_QUEUE_SUCCESS) {
+        myList_t* queue_item = CONTAINER_OF(item, myList_t, node);
+        *data = queue_item->number;
+    }
+
+    return result;
+}
+
+int main() {
+
+    staticQueue_t      queues[NUM_LANES];
+    myList_t           lists[NUM_LANES][LANE_LEN] = {0};
+    staticQueueLanes_t lanes;
+    int32_t            data;
+    uint32_t           lane;
+
+    for (int i = 0; i < NUM_LANES; i++) {
+        STATIC_QUEUE_INIT(&queues[i], lists[i], LANE_LEN);
+    }
+
+    int32_t result = staticQueueLanesInit(&lanes, queues, NUM_LANES);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        printf("Lanes init failed %i\n", result);
+        return 1;
+    }
+
+    // Test 1: Highest priority lane is served first
+    printf("\nTest 1: Pop in priority order\n");
+    lanesPut(&lanes, 31, 310);
+    lanesPut(&lanes, 5, 50);
+    lanesPut(&lanes, 5, 51);
+    lanesPut(&lanes, 0, 0);
+    lanesPut(&lanes, 17, 170);
+
+    if (staticQueueLanesNext(&lanes) != 0) {
+        printf("Expected lane 0 next, got %i\n", staticQueueLanesNext(&lanes));
+        return 1;
+    }
+
+    int32_t  expected_data[] = {0, 50, 51, 170, 310};
+    uint32_t expected_lane[] = {0, 5, 5, 17, 31};
+    for (int i = 0; i < 5; i++) {
+        result = lanesPop(&lanes, &data, &lane);
+        if (result != STATIC_QUEUE_SUCCESS || data != expected_data[i] || lane != expected_lane[i]) {
+            printf("Expected %i from lane %u, got %i from lane %u (result: %i)\n",
+                   expected_data[i], expected_lane[i], data, lane, result);
+            return 1;
+        }
+    }
+
+    result = lanesPop(&lanes, &data, &lane);
+    if (result != STATIC_QUEUE_EMPTY || !staticQueueLanesEmpty(&lanes)) {
+        printf("Expected STATIC_QUEUE_EMPTY, got %i\n", result);
+        return 1;
+    }
+    printf("Test 1 passed: Lanes served in priority order\n");
+
+    // Test 2: Erase keeps the bitmap in sync
+    printf("\nTest 2: Erase clears lane bit\n");
+    staticQueueItem_t* item;
+    staticQueueLanesPut(&lanes, 3, &item);
+    lanesPut(&lanes, 9, 90);
+
+    result = staticQueueLanesErase(&lanes, 3, item);
+    if (result != STATIC_QUEUE_SUCCESS || staticQueueLanesNext(&lanes) != 9) {
+        printf("Expected lane 9 next after erase, got %i\n", staticQueueLanesNext(&lanes));
+        return 1;
+    }
+    printf("Test 2 passed: Bitmap follows erase\n");
+
+    // Test 3: Full lane and invalid lane
+    printf("\nTest 3: Full and invalid lanes\n");
+    for (int i = 0; i < LANE_LEN; i++) {
+        lanesPut(&lanes, 1, i);
+    }
+
+    result = lanesPut(&lanes, 1, 99);
+    if (result != STATIC_QUEUE_FULL) {
+        printf("Expected STATIC_QUEUE_FULL, got %i\n", result);
+        return 1;
+    }
+
+    result = lanesPut(&lanes, NUM_LANES, 99);
+    if (result != STATIC_QUEUE_INVALID) {
+        printf("Expected STATIC_QUEUE_INVALID, got %i\n", result);
+        return 1;
+    }
+    printf("Test 3 passed: Full and invalid lanes rejected\n");
+
+    printf("\nTest Done\n");
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include "static_queue_typed.h"
+#include <stdio.h>
+
+typedef struct {
+    uint32_t number;
+    uint32_t check;
+} myMsg_t;
+
+STATIC_QUEUE_DEFINE(pow2Queue, myMsg_t, 8);
+STATIC_QUEUE_DEFINE(oddQueue, myMsg_t, 5);
+
+int main() {
+
+    pow2Queue_t pow2_queue;
+    oddQueue_t  odd_queue;
+    myMsg_t*    msg;
+    int32_t     result;
+
+    pow2QueueInit(&pow2_queue);
+    oddQueueInit(&odd_queue);
+
+    // Test 1: Fill, overflow and drain in order
+    printf("\nTest 1: Fill and drain\n");
+    for (uint32_t i = 0; i < 5; i++) {
+        oddQueuePut(&odd_queue, &msg);
+        msg->number = i;
+    }
+
+    result = oddQueuePut(&odd_queue, &msg);
+    if (result != STATIC_QUEUE_FULL || !oddQueuefull(&odd_queue) || oddQueueGetNumItems(&odd_queue) != 5) {
+        printf("Expected STATIC_QUEUE_FULL, got %i\n", result);
+        return 1;
+    }
+
+    oddQueuePeak(&odd_queue, &msg);
+    if (msg->number != 0) {
+        printf("Expected 0 first, got %u\n", msg->number);
+        return 1;
+    }
+
+    for (uint32_t i = 0; i < 5; i++) {
+        result = oddQueuePop(&odd_queue, &msg);
+        if (result != STATIC_QUEUE_SUCCESS || msg->number != i) {
+            printf("Expected %u, got %u (result: %i)\n", i, msg->number, result);
+            return 1;
+        }
+    }
+
+    result = oddQueuePop(&odd_queue, &msg);
+    if (result != STATIC_QUEUE_EMPTY || !oddQueueEmpty(&odd_queue)) {
+        printf("Expected STATIC_QUEUE_EMPTY, got %i\n", result);
+        return 1;
+    }
+    printf("Test 1 passed: Fill and drain\n");
+
+    // Test 2: Many laps with varying depth, both the masked and the wrapped positions
+    printf("\nTest 2: Wrap around\n");
+    uint32_t put_count = 0;
+    uint32_t pop_count = 0;
+    for (uint32_t lap = 0; lap < 1000; lap++) {
+        uint32_t puts = lap % 7;
+        for (uint32_t i = 0; i < puts; i++) {
+            if (oddQueuePut(&odd_queue, &msg) == STATIC_QUEUE_SUCCESS) {
+                msg->number = put_count;
+                msg->check  = ~put_count;
+                put_count++;
+            }
+            if (pow2QueuePut(&pow2_queue, &msg) == STATIC_QUEUE_SUCCESS) {
+                msg->number = lap;
+            }
+        }
+
+        uint32_t pops = (lap * 3) % 5;
+        for (uint32_t i = 0; i < pops && oddQueuePop(&odd_queue, &msg) == STATIC_QUEUE_SUCCESS; i++) {
+            if (msg->number != pop_count || msg->check != ~pop_count) {
+                printf("Expected %u, got %u at lap %u\n", pop_count, msg->number, lap);
+                return 1;
+            }
+            pop_count++;
+            pow2QueuePop(&pow2_queue, &msg);
+        }
+
+        if (oddQueueGetNumItems(&odd_queue) != put_count - pop_count) {
+            printf("Expected %u items, got %u at lap %u\n",
+                   put_count - pop_count, oddQueueGetNumItems(&odd_queue), lap);
+            return 1;
+        }
+    }
+    printf("Test 2 passed: Wrap around keeps order\n");
+
+    // Test 3: Free running positions wrap the 32 bit counter
+    printf("\nTest 3: Counter wrap\n");
+    pow2QueueClear(&pow2_queue);
+    pow2_queue.head = UINT32_MAX - 2;
+    pow2_queue.tail = UINT32_MAX - 2;
+    for (uint32_t i = 0; i < 8; i++) {
+        pow2QueuePut(&pow2_queue, &msg);
+        msg->number = i;
+    }
+
+    if (!pow2Queuefull(&pow2_queue)) {
+        printf("Expected a full queue across the counter wrap\n");
+        return 1;
+    }
+
+    for (uint32_t i = 0; i < 8; i++) {
+        pow2QueuePop(&pow2_queue, &msg);
+        if (msg->number != i) {
+            printf("Expected %u, got %u\n", i, msg->number);
+            return 1;
+        }
+    }
+    printf("Test 3 passed: Counter wrap\n");
+
+    printf("\nTest Done\n");
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include "static_thread_pool.h"
+#include <sched.h>
+#include <stdio.h>
+
+#define NUM_WORKERS      4
+#define TASKS_PER_WORKER 16
+#define NUM_TASKS        10000u
+#define BATCH            32
+
+static uint32_t g_counter = 0;
+static bool     g_gate    = false;
+
+static void countTask(void* arg)
+{
+    __atomic_add_fetch(&g_counter, (uint32_t)(uintptr_t)arg, __ATOMIC_RELAXED);
+}
+
+static void gatedTask(void* arg)
+{
+    while (!__atomic_load_n(&g_gate, __ATOMIC_ACQUIRE)) {
+        sched_yield();
+    }
+    countTask(arg);
+}
+
+// Yield until count workers sleep, false if it takes too long
+static bool waitSleeping(staticThreadPoolWorker_t* workers, uint32_t count)
+{
+    for (uint32_t round = 0; round < 1000000; round++) {
+        uint32_t sleeping = 0;
+        for (uint32_t i = 0; i < NUM_WORKERS; i++) {
+            sleeping += __atomic_load_n(&workers[i].sleeping, __ATOMIC_RELAXED);
+        }
+        if (sleeping == count) {
+            return true;
+        }
+        sched_yield();
+    }
+
+    return false;
+}
+
+int main() {
+
+    staticPoolTask_t         tasks[NUM_WORKERS * TASKS_PER_WORKER];
+    staticThreadPoolWorker_t workers[NUM_WORKERS];
+    staticThreadPool_t       pool;
+    void*                    args[BATCH];
+
+    int32_t result = staticThreadPoolInit(&pool, workers, NUM_WORKERS, tasks, TASKS_PER_WORKER);
+    if (result != STATIC_QUEUE_SUCCESS) {
+        printf("Pool init failed %i\n", result);
+        return 1;
+    }
+
+    // Test 1: Batched submissions, retried when the shards are full, all run before WaitAll returns
+    printf("\nTest 1: Batched submit and wait all\n");
+    for (uint32_t i = 0; i < BATCH; i++) {
+        args[i] = (void*)(uintptr_t)1;
+    }
+
+    uint32_t submitted = 0;
+    while (submitted < NUM_TASKS) {
+        uint32_t want = NUM_TASKS - submitted < BATCH ? NUM_TASKS - submitted : BATCH;
+        result        = staticThreadPoolSubmitMany(&pool, countTask, args, want);
+        if (result > 0) {
+            submitted += result;
+        } else {
+            sched_yield();
+        }
+    }
+    staticThreadPoolWaitAll(&pool);
+
+    if (g_counter != NUM_TASKS || pool.pending != 0) {
+        printf("Expected %u tasks run, got %u\n", NUM_TASKS, g_counter);
+        return 1;
+    }
+    printf("Test 1 passed: %u tasks run\n", NUM_TASKS);
+
+    // Test 2: With every worker blocked the shards fill up and submit reports it
+    printf("\nTest 2: Full pool\n");
+    g_counter       = 0;
+    uint32_t queued = 0;
+    for (uint32_t i = 0; i < 1000; i++) {
+        result = staticThreadPoolSubmit(&pool, gatedTask, (void*)(uintptr_t)1);
+        if (result == STATIC_QUEUE_FULL) {
+            break;
+        }
+        queued++;
+    }
+
+    if (result != STATIC_QUEUE_FULL || queued < NUM_WORKERS * TASKS_PER_WORKER) {
+        printf("Expected STATIC_QUEUE_FULL after at least %u tasks, got %i after %u\n",
+               NUM_WORKERS * TASKS_PER_WORKER, result, queued);
+        return 1;
+    }
+
+    __atomic_store_n(&g_gate, true, __ATOMIC_RELEASE);
+    staticThreadPoolWaitAll(&pool);
+    if (g_counter != queued) {
+        printf("Expected %u gated tasks run, got %u\n", queued, g_counter);
+        return 1;
+    }
+    printf("Test 2 passed: Full reported, %u queued tasks run\n", queued);
+
+    // Test 3: Tasks put behind a blocked worker are taken by the sleeping ones
+    printf("\nTest 3: Sleeping workers take work from a busy shard\n");
+    g_counter = 0;
+    __atomic_store_n(&g_gate, false, __ATOMIC_RELEASE);
+    if (!waitSleeping(workers, NUM_WORKERS)) {
+        printf("Expected all workers to sleep\n");
+        return 1;
+    }
+    staticThreadPoolSubmit(&pool, gatedTask, (void*)(uintptr_t)1);
+    if (!waitSleeping(workers, NUM_WORKERS - 1)) {
+        printf("Expected all but the blocked worker to sleep\n");
+        return 1;
+    }
+
+    // One at a time with the others asleep in between, round robin alone would hit the blocked shard
+    uint32_t run = 0;
+    for (uint32_t i = 0; i < NUM_WORKERS * 2 && run == i; i++) {
+        staticThreadPoolSubmit(&pool, countTask, (void*)(uintptr_t)1);
+        for (uint32_t round = 0; round < 100000 && __atomic_load_n(&g_counter, __ATOMIC_RELAXED) == i; round++) {
+            sched_yield();
+        }
+        run = __atomic_load_n(&g_counter, __ATOMIC_RELAXED);
+        waitSleeping(workers, NUM_WORKERS - 1);
+    }
+
+    __atomic_store_n(&g_gate, true, __ATOMIC_RELEASE);
+    staticThreadPoolWaitAll(&pool);
+    if (run != NUM_WORKERS * 2) {
+        printf("Expected %u tasks run beside the blocked worker, got %u\n", NUM_WORKERS * 2, run);
+        return 1;
+    }
+    printf("Test 3 passed: No task waited for the blocked worker\n");
+
+    staticThreadPoolDestroy(&pool);
+
+    printf("\nTest Done\n");
+    return 0;
+}